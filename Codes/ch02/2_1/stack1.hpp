@@ -2,6 +2,12 @@
 #define CXX_TEMPLATES_STACK1_HPP
 #include <vector>
 #include <cassert>
+#include "../../ch03/3_1/stackpacked.hpp"
+#include <cstddef>
+#include <iterator>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
 
 template<typename T>
 class Stack
@@ -16,6 +22,26 @@ public:
     {
         return elems.empty();
     }
+    std::size_t size() const        // return number of elements
+    {
+        return elems.size();
+    }
+
+    // read-only iteration: begin()/end() from bottom to top, rbegin()/rend() from top to bottom
+    using const_iterator = typename std::vector<T>::const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    const_iterator begin() const { return elems.begin(); }
+    const_iterator end() const { return elems.end(); }
+    const_reverse_iterator rbegin() const { return elems.rbegin(); }
+    const_reverse_iterator rend() const { return elems.rend(); }
+
+#if __cplusplus >= 202002L
+    // the whole stack as a span, index 0 is the bottom
+    std::span<T const> view() const
+    {
+        return std::span<T const>(elems.data(), elems.size());
+    }
+#endif
 };
 
 template<typename T>
@@ -37,4 +63,12 @@ T const& Stack<T>::top() const
     assert(!elems.empty());
     return elems.back();            // return copy of the last element
 }
+
+// specialization for bool: one bit per element instead of std::vector<bool>,
+// declared right after the primary template so that every user of Stack<bool> sees it.
+// top() returns the value rather than a reference; no iterators or view()
+template<>
+class Stack<bool> : public PackedStack<bool, 1>
+{
+};
 #endif //CXX_TEMPLATES_STACK1_HPP
\ No newline at end of file
@@ -1,7 +1,10 @@
 #include "../2_1/stack1.hpp"
+#include "../../ch05/5_7/stacksegments.hpp"
 #include <deque>
 #include <string>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
 
 template<>
 class Stack<std::string>
@@ -16,6 +19,26 @@ public:
     {
         return elems.empty();
     }
+    std::size_t size() const                // 返回元素个数
+    {
+        return elems.size();
+    }
+
+    // 只读遍历：begin()/end() 从栈底到栈顶，rbegin()/rend() 从栈顶到栈底。
+    // deque 不是连续存放的，没有 span 视图
+    using const_iterator = std::deque<std::string>::const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    const_iterator begin() const { return elems.begin(); }
+    const_iterator end() const { return elems.end(); }
+    const_reverse_iterator rbegin() const { return elems.rbegin(); }
+    const_reverse_iterator rend() const { return elems.rend(); }
+
+    // 分段遍历：从栈底到栈顶，对 deque 的每个块调用 f(std::string const* first, std::string const* last)
+    template<typename F>
+    void forEachSegment(F f) const
+    {
+        stackdetail::forEachSegment<std::string>(elems, f);
+    }
 };
 
 void Stack<std::string>::push(std::string const& elem)
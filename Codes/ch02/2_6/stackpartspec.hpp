@@ -1,20 +1,28 @@
+#ifndef CXX_TEMPLATES_STACKPARTSPEC_HPP
+#define CXX_TEMPLATES_STACKPARTSPEC_HPP
 #include "../2_1/stack1.hpp"
+#include <cstring>
+#include <type_traits>
 
 // 为指针而实现的 Stack<> 的部分特例化
+// 所有 Stack<T*> 共用同一份非模板的 Stack<void*> 实现，Stack<T*> 只是一层做类型转换的内联外壳，
+// 无论有多少种指向的类型，push/pop/top 的代码都只生成一份。
+// 函数指针是例外，见 FunctionPtrStack。
 
-template <typename T>
-class Stack<T*>
+// 全特化：唯一真正操作 vector 的代码
+template <>
+class Stack<void*>
 {
 private:
     // 元素
-    std::vector<T*> elems;
+    std::vector<void*> elems;
 public:
     // 栈顶插入指针
-    void push(T*);
+    void push(void*);
     // 推出栈顶指针
-    T* pop();
+    void* pop();
     // 返回栈顶元素
-    T* top() const
+    void* top() const;
     // 返回栈是否为空
     bool empty() const
     {
@@ -22,24 +30,130 @@ public:
     }
 };
 
-template <typename T>
-void Stack<T*>::push(T* elem)
+// 不是模板，定义在头文件中需要 inline
+inline void Stack<void*>::push(void* elem)
 {
     elems.push_back(elem);
 }
 
-template <typename T>
-T* Stack<T*>::pop()
+inline void* Stack<void*>::pop()
 {
     assert(!elems.empty());
-    T* p = elems.back();
+    void* p = elems.back();
     elems.pop_back();
     return p;
 }
 
-template <typename T>
-T* Stack<T*>::top() const
+inline void* Stack<void*>::top() const
 {
     assert(!elems.empty());
     return elems.back();
-}
\ No newline at end of file
+}
+
+// 函数指针与 void* 之间的转换只是“有条件支持”，不能共用 Stack<void*>：
+// 每种函数指针类型各自实例化一份，与书中原来的部分特例化相同
+template <typename F>
+class FunctionPtrStack
+{
+private:
+    std::vector<F*> elems;
+public:
+    void push(F* elem)
+    {
+        elems.push_back(elem);
+    }
+    F* pop()
+    {
+        assert(!elems.empty());
+        F* p = elems.back();
+        elems.pop_back();
+        return p;
+    }
+    F* top() const
+    {
+        assert(!elems.empty());
+        return elems.back();
+    }
+    bool empty() const
+    {
+        return elems.empty();
+    }
+};
+
+template <typename T>
+class Stack<T*> : private std::conditional_t<std::is_function_v<T>, FunctionPtrStack<T>, Stack<void*>>
+{
+private:
+    using Base = std::conditional_t<std::is_function_v<T>, FunctionPtrStack<T>, Stack<void*>>;
+    // 对象指针去掉 const/volatile 后转换为 void*，取出时再转换回来；函数指针原样存取
+    static auto erase(T* p)
+    {
+        if constexpr (std::is_function_v<T>) {
+            return p;
+        }
+        else {
+            return const_cast<void*>(static_cast<void const volatile*>(p));
+        }
+    }
+    template <typename P>
+    static T* restore(P p)
+    {
+        return static_cast<T*>(p);
+    }
+public:
+    // 栈顶插入指针
+    void push(T* elem)
+    {
+        Base::push(erase(elem));
+    }
+    // 推出栈顶指针
+    T* pop()
+    {
+        return restore(Base::pop());
+    }
+    // 返回栈顶元素
+    T* top() const
+    {
+        return restore(Base::top());
+    }
+    // 返回栈是否为空
+    using Base::empty;
+};
+
+// 同样的技术用于其他与指针大小相同的可平凡拷贝类型（句柄、下标、64 位整数等）：
+// 按字节存入 void*，取出时再按字节还原
+template <typename T>
+class ThinStack : private Stack<void*>
+{
+private:
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) == sizeof(void*),
+                  "ThinStack<T>: T must be trivially copyable and pointer-sized");
+    using Base = Stack<void*>;
+    static void* erase(T const& x)
+    {
+        void* p;
+        std::memcpy(&p, &x, sizeof(p));
+        return p;
+    }
+    static T restore(void* p)
+    {
+        T x;
+        std::memcpy(&x, &p, sizeof(x));
+        return x;
+    }
+public:
+    void push(T const& elem)
+    {
+        Base::push(erase(elem));
+    }
+    T pop()
+    {
+        return restore(Base::pop());
+    }
+    T top() const
+    {
+        return restore(Base::top());
+    }
+    using Base::empty;
+};
+#endif //CXX_TEMPLATES_STACKPARTSPEC_HPP
@@ -0,0 +1,77 @@
+#!/bin/sh
+# 代码体积基准：生成使用 N 种不同指针类型 Stack<T*> 的程序，对比
+#   before：书中原来的部分特例化，每种 T 各自实例化一份 vector<T*> 的代码；
+#   after ：stackpartspec.hpp 中的外壳 + Stack<void*> 核心。
+# 报告 .text 大小、Stack 相关的函数个数和轮流使用全部类型时的运行时间；
+# 有 perf 时再报告指令缓存缺失。
+# 用法：sh thinbench.sh [N] [g++]
+N=${1:-500}
+CXX=${2:-g++}
+DIR=$(cd "$(dirname "$0")" && pwd)
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+seq0() { i=0; while [ $i -lt "$1" ]; do echo $i; i=$((i + 1)); done; }
+
+before() {
+    cat <<'EOT'
+#include "STACK1"
+
+template <typename T>
+class Stack<T*>
+{
+private:
+    std::vector<T*> elems;
+public:
+    void push(T* elem) { elems.push_back(elem); }
+    T* pop() { assert(!elems.empty()); T* p = elems.back(); elems.pop_back(); return p; }
+    T* top() const { assert(!elems.empty()); return elems.back(); }
+    bool empty() const { return elems.empty(); }
+};
+EOT
+}
+
+# 每种类型一个不内联的函数：压入、读取栈顶、全部弹出
+program() {
+    echo "#include <chrono>"
+    echo "#include <cstdio>"
+    for i in $(seq0 "$N"); do
+        echo "struct T$i { long v = $i; };"
+        echo "[[gnu::noinline]] long use$i(int n) { static T$i x; Stack<T$i*> s; long r = 0;"
+        echo "    for (int k = 0; k < n; ++k) { s.push(&x); r += s.top()->v; }"
+        echo "    while (!s.empty()) { r += s.pop()->v; } return r; }"
+    done
+    echo "long (*const uses[])(int) = {$(seq0 "$N" | sed 's/^/use/' | paste -sd, -)};"
+    cat <<'EOT'
+int main()
+{
+    auto start = std::chrono::steady_clock::now();
+    long r = 0;
+    for (int round = 0; round < 2000; ++round) {
+        for (auto use : uses) {
+            r += use(8);
+        }
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%.1f ms (%ld)\n", ms, r);
+}
+EOT
+}
+
+{ before | sed "s|STACK1|$DIR/../2_1/stack1.hpp|"; program; } > "$TMP/before.cpp"
+{ echo "#include \"$DIR/stackpartspec.hpp\""; program; } > "$TMP/after.cpp"
+
+echo "| variant | .text bytes | Stack/vector functions | run time |"
+echo "|---|---|---|---|"
+for v in before after; do
+    $CXX -std=c++17 -O2 -DNDEBUG "$TMP/$v.cpp" -o "$TMP/$v" || exit 1
+    text=$(size "$TMP/$v" | awk 'NR == 2 { print $1 }')
+    funcs=$(nm -C "$TMP/$v" | grep -c -E ' [TtWw] .*(Stack<|std::vector<)')
+    echo "| $v | $text | $funcs | $("$TMP/$v" | cut -d' ' -f1-2) |"
+done
+if command -v perf > /dev/null; then
+    for v in before after; do
+        echo "$v:"
+        perf stat -e instructions,L1-icache-load-misses,iTLB-load-misses "$TMP/$v" 2>&1 | grep -E 'instructions|misses'
+    done
+fi
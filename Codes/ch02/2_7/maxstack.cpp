@@ -0,0 +1,118 @@
+#include "maxstack.hpp"
+#include "../../ch01/1_1/max1.hpp"
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+// 原来的做法：Stack 不能遍历，只能拷贝一份后逐个弹出，用 ::max 求最大值
+template<typename T>
+T scanMax(Stack<T> s)
+{
+    T m = s.top();
+    for (s.pop(); !s.empty(); s.pop()) {
+        m = ::max(m, s.top());
+    }
+    return m;
+}
+
+int main()
+{
+    // 自定义比较器：最长的字符串
+    auto longer = [](std::string const& a, std::string const& b) { return a.size() < b.size(); };
+    MaxStack<std::string, decltype(longer)> words(longer);
+    for (char const* w : {"template", "typename", "constexpr", "auto", "decltype"}) {
+        words.push(w);
+    }
+    std::cout << "longest: " << words.max() << '\n';
+    words.pop();
+    words.pop();
+    words.pop();
+    std::cout << "after 3 pops: " << words.max() << '\n';
+
+    // 栈：随机压入/弹出，每次操作后查询最大值，深度在 depth 附近波动
+    std::mt19937 rng(1);
+    constexpr int ops = 200'000;
+    for (int depth : {16, 256, 4096}) {
+        std::vector<int> values(ops);
+        std::vector<bool> pushes(ops);
+        int size = depth;
+        for (int i = 0; i < ops; ++i) {
+            values[i] = static_cast<int>(rng() % 1'000'000);
+            pushes[i] = size <= depth / 2 || (size < 2 * depth && rng() % 2 == 0);
+            size += pushes[i] ? 1 : -1;
+        }
+        Stack<int> plain;
+        MaxStack<int> tracked;
+        for (int i = 0; i < depth; ++i) {
+            plain.push(values[i]);
+            tracked.push(values[i]);
+        }
+        long a = 0, b = 0;
+        double scan = measure([&] {
+            for (int i = 0; i < ops; ++i) {
+                if (pushes[i]) {
+                    plain.push(values[i]);
+                }
+                else {
+                    plain.pop();
+                }
+                a += scanMax(plain);
+            }
+        });
+        double fast = measure([&] {
+            for (int i = 0; i < ops; ++i) {
+                if (pushes[i]) {
+                    tracked.push(values[i]);
+                }
+                else {
+                    tracked.pop();
+                }
+                b += tracked.max();
+            }
+        });
+        std::cout << "stack depth ~" << depth << ": copy + scan " << scan * 1e6 / ops << " ns/op, MaxStack "
+                  << fast * 1e6 / ops << " ns/op" << (a == b ? "" : " (MISMATCH)") << '\n';
+    }
+
+    // 滑动窗口最大值：扫描窗口 vs MaxQueue
+    constexpr int n = 1'000'000;
+    std::vector<int> stream(n);
+    for (auto& x : stream) {
+        x = static_cast<int>(rng() % 1'000'000);
+    }
+    for (std::size_t window : {8, 64, 1024}) {
+        long a = 0, b = 0;
+        double scan = measure([&] {
+            for (std::size_t i = 0; i < stream.size(); ++i) {
+                std::size_t first = i + 1 >= window ? i + 1 - window : 0;
+                int m = stream[first];
+                for (std::size_t k = first + 1; k <= i; ++k) {
+                    m = ::max(m, stream[k]);
+                }
+                a += m;
+            }
+        });
+        double fast = measure([&] {
+            MaxQueue<int> q(window);
+            for (int x : stream) {
+                q.push(x);
+                b += q.max();
+            }
+        });
+        std::cout << "window " << window << ": scan " << scan * 1e6 / n << " ns/elem, MaxQueue "
+                  << fast * 1e6 / n << " ns/elem" << (a == b ? "" : " (MISMATCH)") << '\n';
+    }
+}
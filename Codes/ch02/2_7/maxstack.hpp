@@ -0,0 +1,125 @@
+#ifndef CXX_TEMPLATES_MAXSTACK_HPP
+#define CXX_TEMPLATES_MAXSTACK_HPP
+#include "stack3.hpp"
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// 随时可以取得当前最大元素的栈：除了元素栈，再用一个 Stack 记录“到目前为止的最大值”，
+// 只有不小于当前最大值的元素才压入这个辅助栈，弹出的元素等于当前最大值时一起弹出。
+// push、pop、top、max() 都是 O(1)。Compare 与 std::max 的比较器含义相同（默认 std::less<T>）。
+template <typename T, typename Compare = std::less<T>, typename Cont = std::vector<T>>
+class MaxStack
+{
+private:
+    Stack<T, Cont> elems;
+    Stack<T, Cont> maxima;      // 从底到顶单调不减
+    Compare comp;
+
+    bool equivalent(T const& a, T const& b) const
+    {
+        return !comp(a, b) && !comp(b, a);
+    }
+public:
+    MaxStack() = default;
+    explicit MaxStack(Compare c) : comp(std::move(c)) {}
+
+    // 插入元素到栈顶
+    void push(T const& elem)
+    {
+        if (maxima.empty() || !comp(elem, maxima.top())) {
+            maxima.push(elem);
+        }
+        elems.push(elem);
+    }
+    // 删除栈顶元素
+    void pop()
+    {
+        assert(!elems.empty());
+        if (equivalent(elems.top(), maxima.top())) {
+            maxima.pop();
+        }
+        elems.pop();
+    }
+    // 返回栈顶元素
+    T const& top() const
+    {
+        return elems.top();
+    }
+    // 返回当前最大元素
+    T const& max() const
+    {
+        return maxima.top();
+    }
+    // 判断是否为空
+    bool empty() const
+    {
+        return elems.empty();
+    }
+};
+
+// 队列版本，用于流上的滑动窗口最大值：辅助的 deque 从头到尾单调不增，
+// 新元素入队时先移除队尾所有比它小的元素，它们在新元素离开窗口之前不可能成为最大值。
+// push、pop 均摊 O(1)，front、max() O(1)。
+// 构造时给出 window 后，push 在元素个数超过 window 时自动弹出最早的元素。
+template <typename T, typename Compare = std::less<T>, typename Cont = std::deque<T>>
+class MaxQueue
+{
+private:
+    Cont elems;
+    Cont maxima;                // 从头到尾单调不增
+    std::size_t window;         // 0 表示不限制
+    Compare comp;
+public:
+    explicit MaxQueue(std::size_t window = 0, Compare c = Compare())
+        : window(window), comp(std::move(c))
+    {
+    }
+
+    // 插入元素到队尾
+    void push(T const& elem)
+    {
+        while (!maxima.empty() && comp(maxima.back(), elem)) {
+            maxima.pop_back();
+        }
+        maxima.push_back(elem);
+        elems.push_back(elem);
+        if (window != 0 && elems.size() > window) {
+            pop();
+        }
+    }
+    // 删除队头元素
+    void pop()
+    {
+        assert(!elems.empty());
+        // 队头元素如果还在辅助队列中，一定就在辅助队列的头部
+        if (!comp(elems.front(), maxima.front())) {
+            maxima.pop_front();
+        }
+        elems.pop_front();
+    }
+    // 返回队头元素
+    T const& front() const
+    {
+        assert(!elems.empty());
+        return elems.front();
+    }
+    // 返回当前最大元素
+    T const& max() const
+    {
+        assert(!maxima.empty());
+        return maxima.front();
+    }
+    bool empty() const
+    {
+        return elems.empty();
+    }
+    std::size_t size() const
+    {
+        return elems.size();
+    }
+};
+#endif //CXX_TEMPLATES_MAXSTACK_HPP
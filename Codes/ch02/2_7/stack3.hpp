@@ -1,5 +1,14 @@
+#ifndef CXX_TEMPLATES_STACK3_HPP
+#define CXX_TEMPLATES_STACK3_HPP
+#include "../../ch05/5_7/stacksegments.hpp"
 #include <vector>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
+#if __cplusplus >= 202002L
+#include <ranges>
+#include <span>
+#endif
 
 template <typename T, typename Cont = std::vector<T>>
 class Stack
@@ -18,6 +27,36 @@ public:
     {
         return elems.empty();
     }
+    // 返回元素个数
+    std::size_t size() const
+    {
+        return elems.size();
+    }
+
+    // 只读遍历：begin()/end() 从栈底到栈顶，rbegin()/rend() 从栈顶到栈底
+    using const_iterator = typename Cont::const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    const_iterator begin() const { return elems.begin(); }
+    const_iterator end() const { return elems.end(); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(elems.end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(elems.begin()); }
+
+#if __cplusplus >= 202002L
+    // 连续存放的容器（如 vector）：整个栈作为一个 span，下标 0 是栈底
+    std::span<T const> view() const
+        requires std::ranges::contiguous_range<Cont const>
+    {
+        return std::span<T const>(std::ranges::data(elems), std::ranges::size(elems));
+    }
+#endif
+
+    // 分段遍历：从栈底到栈顶，对每个连续存放的段调用 f(T const* first, T const* last)；
+    // vector 只有一段，deque 每个块一段
+    template <typename F>
+    void forEachSegment(F f) const
+    {
+        stackdetail::forEachSegment<T>(elems, f);
+    }
 };
 
 template <typename T, typename Cont>
@@ -38,4 +77,5 @@ T const& Stack<T, Cont>::top() const
 {
     assert(!elems.empty());
     return elems.back();
-}
\ No newline at end of file
+}
+#endif //CXX_TEMPLATES_STACK3_HPP
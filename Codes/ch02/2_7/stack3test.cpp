@@ -19,6 +19,20 @@ int main()
     dblStack.push(42.42);
     std::cout << dblStack.top() << std::endl;
     dblStack.pop();
+
+    // 分段遍历：deque 每个块一段
+    for (int i = 0; i < 1000; ++i) {
+        dblStack.push(i);
+    }
+    double sum = 0;
+    int segments = 0;
+    dblStack.forEachSegment([&](double const* first, double const* last) {
+        ++segments;
+        for (; first != last; ++first) {
+            sum += *first;
+        }
+    });
+    std::cout << sum << " in " << segments << " segments" << std::endl;
     
     return 0;
 }
\ No newline at end of file
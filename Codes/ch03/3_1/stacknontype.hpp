@@ -1,5 +1,9 @@
 #include <array>
 #include <cassert>
+#include <iterator>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
 
 template<typename T, std::size_t Maxsize>
 class Stack {
@@ -17,6 +21,27 @@ public:
     std::size_t size() const {      // 返回当前元素个数
         return numElems;
     }
+
+    // 只读遍历：begin()/end() 从栈底到栈顶，rbegin()/rend() 从栈顶到栈底
+    using const_iterator = typename std::array<T, Maxsize>::const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    const_iterator begin() const {
+        return elems.begin();
+    }
+    const_iterator end() const {
+        return elems.begin() + numElems;
+    }
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+#if __cplusplus >= 202002L
+    std::span<T const> view() const {  // 已有元素的视图，下标 0 是栈底
+        return std::span<T const>(elems.data(), numElems);
+    }
+#endif
 };
 
 template<typename T, std::size_t Maxsize>
@@ -0,0 +1,152 @@
+#include "../../ch02/2_1/stack1.hpp"
+#include "stackpacked.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <vector>
+
+// 统计当前在堆上的字节数，用于比较栈最深时的内存占用：每块内存前面记录它的大小
+static std::size_t liveBytes = 0;
+
+void* operator new(std::size_t n)
+{
+    if (auto p = static_cast<std::max_align_t*>(std::malloc(n + sizeof(std::max_align_t)))) {
+        *reinterpret_cast<std::size_t*>(p) = n;
+        liveBytes += n;
+        return p + 1;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p != nullptr) {
+        auto q = static_cast<std::max_align_t*>(p) - 1;
+        liveBytes -= *reinterpret_cast<std::size_t*>(q);
+        std::free(q);
+    }
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+// 解析器状态：2 位足够，底层类型是 int 时在通用的 Stack 中每个元素占 4 字节
+enum class State { Start, Name, Value, End };
+// 底层类型为单字节的状态，可以走 push_range 的批量打包
+enum class Flag : std::uint8_t { Off, On, Pending, Error };
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+// 解析器式的访问：压入、读取栈顶、弹出交替进行，栈深度在一个范围内波动
+template<typename S, typename T>
+long churn(S& s, std::vector<T> const& in)
+{
+    long r = 0;
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        s.push(in[i]);
+        if ((i & 3) == 3) {
+            r += static_cast<long>(s.top());
+            s.pop();
+            s.pop();
+        }
+    }
+    while (!s.empty()) {
+        r += static_cast<long>(s.top());
+        s.pop();
+    }
+    return r;
+}
+
+// 把 in 全部压入后（栈最深时）S 在堆上占用的字节数
+template<typename S, typename T>
+std::size_t footprint(std::vector<T> const& in)
+{
+    std::size_t before = liveBytes;
+    S s;
+    for (auto const& x : in) {
+        s.push(x);
+    }
+    return liveBytes - before;
+}
+
+// Generic 是 stack1.hpp 中通用的 Stack（vector<T>，每个元素 sizeof(T) 字节），Packed 是按位压缩的版本
+template<typename Generic, typename Packed, typename T>
+void compare(char const* name, std::vector<T> const& in)
+{
+    long rg = 0, rp = 0;
+    double ms[2];
+    ms[0] = measure([&] {
+        Generic g;
+        rg = churn(g, in);
+    });
+    ms[1] = measure([&] {
+        Packed p;
+        rp = churn(p, in);
+    });
+    std::cout << name << ": generic " << ms[0] << " ms / " << footprint<Generic>(in) / 1024 << " KiB, packed "
+              << ms[1] << " ms / " << footprint<Packed>(in) / 1024 << " KiB" << (rg == rp ? "" : " (MISMATCH)")
+              << '\n';
+}
+
+template<typename T, unsigned Bits>
+void bulk(char const* name, T const* first, T const* last)
+{
+    PackedStack<T, Bits> a, b;
+    a.push(T{});                        // 错开一个元素，检验补齐当前字的路径
+    b.push(T{});
+    double loop = measure([&] {
+        for (T const* p = first; p != last; ++p) {
+            a.push(*p);
+        }
+    });
+    double range = measure([&] { b.push_range(first, last); });
+    bool same = a.size() == b.size();
+    for (; same && !a.empty(); a.pop(), b.pop()) {
+        same = a.top() == b.top();
+    }
+    std::cout << name << ": push loop " << loop << " ms, push_range " << range << " ms"
+              << (same ? "" : " (MISMATCH)") << '\n';
+}
+
+int main()
+{
+    constexpr std::size_t n = 20'000'000;
+    std::mt19937 rng(1);
+    std::vector<bool> boolsV(n);
+    std::unique_ptr<bool[]> bools(new bool[n]);
+    std::vector<State> states(n);
+    std::vector<Flag> flags(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        auto r = rng();
+        boolsV[i] = r & 1;
+        bools[i] = r & 1;
+        states[i] = static_cast<State>(r >> 8 & 3);
+        flags[i] = static_cast<Flag>(r >> 16 & 3);
+    }
+
+    // Stack<bool> 的特例化（stack1.hpp）与每个元素一个字节的通用 Stack<char>
+    compare<Stack<char>, Stack<bool>>("Stack<bool> vs Stack<char>", boolsV);
+    compare<Stack<State>, PackedStack<State, 2>>("Stack<State> (int enum)   ", states);
+    compare<Stack<Flag>, PackedStack<Flag, 2>>("Stack<Flag> (uint8 enum)  ", flags);
+
+    bulk<bool, 1>("bits=1 (bool)   ", bools.get(), bools.get() + n);
+    bulk<Flag, 2>("bits=2 (Flag)   ", flags.data(), flags.data() + n);
+    std::vector<std::uint8_t> nibbles(n);
+    for (auto& x : nibbles) {
+        x = rng() & 15;
+    }
+    bulk<std::uint8_t, 4>("bits=4 (uint8_t)", nibbles.data(), nibbles.data() + n);
+}
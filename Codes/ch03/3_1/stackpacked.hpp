@@ -0,0 +1,191 @@
+#ifndef CXX_TEMPLATES_STACKPACKED_HPP
+#define CXX_TEMPLATES_STACKPACKED_HPP
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#if defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// 按位压缩的栈：每个元素只占 Bits 位，64 / Bits 个元素放在一个 64 位字中，
+// 元素 i 位于第 i / (64 / Bits) 个字的第 (i % (64 / Bits)) * Bits 位。
+//   PackedStack<bool, 1>：stack1.hpp 中 Stack<bool> 的实现，代替 std::vector<bool> 的代理引用；
+//   PackedStack<State, 2>：2 位就能表示的枚举或 uint8_t 标志，不再每个元素占一个字节或一个字。
+// T 可以是 bool、无符号整数或枚举，值必须能用 Bits 位表示（不支持负数），push 与 push_range 都用 assert 检查。
+// 与 vector<bool> 一样，top() 返回值而不是引用。
+// push/pop/top 只有移位和掩码，没有依赖于数据或字边界的分支：栈顶所在的字总是已经分配，
+// 只有 words 需要扩容时（次数与元素个数成对数关系）才进入 grow()。
+// push_range() 对连续存放的单字节元素（bool、uint8_t、底层类型为单字节的枚举）批量打包：
+// Bits == 1 时用 AVX2 一次处理 32 个，其他位宽用 BMI2 的 pext 一次处理 8 个。
+
+template<typename T, unsigned Bits>
+class PackedStack
+{
+private:
+    static_assert(Bits >= 1 && Bits <= 32 && (Bits & (Bits - 1)) == 0, "Bits must be a power of two <= 32");
+    static_assert(std::is_same_v<T, bool> || std::is_enum_v<T> || std::is_unsigned_v<T>,
+                  "PackedStack<T>: T must be bool, an unsigned integer or an enum");
+
+    static constexpr std::size_t PerWord = 64 / Bits;
+    static constexpr std::uint64_t Mask = (std::uint64_t(1) << Bits) - 1;
+
+    std::vector<std::uint64_t> words;   // 高于栈顶的位始终为 0；下一个位置所在的字总是存在
+    std::size_t numElems = 0;           // 当前元素个数
+    std::size_t limit = PerWord;        // numElems 达到它时需要扩容：words.size() * PerWord
+
+    static std::uint64_t encode(T const& elem)
+    {
+        std::uint64_t v;
+        if constexpr (std::is_enum_v<T>) {
+            v = static_cast<std::uint64_t>(static_cast<std::underlying_type_t<T>>(elem));
+        }
+        else {
+            v = static_cast<std::uint64_t>(elem);
+        }
+        assert(v <= Mask);
+        return v;
+    }
+
+    static T decode(std::uint64_t v)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            return v != 0;
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            return static_cast<T>(static_cast<std::underlying_type_t<T>>(v));
+        }
+        else {
+            return static_cast<T>(v);
+        }
+    }
+
+    // 从 p 开始的 PerWord 个单字节元素打包成一个字
+    static std::uint64_t packWord(unsigned char const* p)
+    {
+#ifdef __AVX2__
+        if constexpr (Bits == 1) {
+            // 每个字节的最低位左移到最高位，movemask 收集 32 个最高位
+            __m256i lo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+            __m256i hi = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + 32));
+            auto mlo = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_slli_epi16(lo, 7)));
+            auto mhi = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_slli_epi16(hi, 7)));
+            return mlo | (std::uint64_t(mhi) << 32);
+        }
+#endif
+#ifdef __BMI2__
+        if constexpr (Bits <= 8) {
+            // 每 8 个字节用 pext 取出各自的低 Bits 位，拼成 8 * Bits 位
+            constexpr std::uint64_t byteMask = Mask * 0x0101010101010101ull;
+            std::uint64_t w = 0;
+            for (std::size_t k = 0; k < PerWord / 8; ++k) {
+                std::uint64_t bytes;
+                std::memcpy(&bytes, p + k * 8, 8);
+                w |= _pext_u64(bytes, byteMask) << (k * 8 * Bits);
+            }
+            return w;
+        }
+#endif
+        std::uint64_t w = 0;
+        for (std::size_t k = 0; k < PerWord; ++k) {
+            w |= (std::uint64_t(p[k]) & Mask) << (k * Bits);
+        }
+        return w;
+    }
+
+    // 保证能再容纳 n 个元素，新字为 0
+    void reserveElems(std::size_t n)
+    {
+        std::size_t need = (numElems + n) / PerWord + 1;
+        if (need > words.size()) {
+            words.resize(need > 2 * words.size() ? need : 2 * words.size());
+            limit = words.size() * PerWord;
+        }
+    }
+
+    [[gnu::noinline]] void grow()
+    {
+        reserveElems(1);
+    }
+
+public:
+    PackedStack() : words(1) {}
+
+    // 插入元素到栈顶：写入位置所在的字已经存在，不需要在字边界上分支
+    void push(T const& elem)
+    {
+        std::size_t n = numElems;           // 局部副本：写 words 后不必重新读取 numElems
+        words[n / PerWord] |= encode(elem) << ((n % PerWord) * Bits);
+        numElems = n + 1;
+        if (n + 1 == limit) {
+            grow();
+        }
+    }
+
+    // 删除栈顶元素：清除它的位，字本身保留
+    void pop()
+    {
+        assert(numElems > 0);
+        --numElems;
+        words[numElems / PerWord] &= ~(Mask << ((numElems % PerWord) * Bits));
+    }
+
+    // 返回栈顶元素
+    T top() const
+    {
+        assert(numElems > 0);
+        std::size_t i = numElems - 1;
+        return decode((words[i / PerWord] >> ((i % PerWord) * Bits)) & Mask);
+    }
+
+    bool empty() const
+    {
+        return numElems == 0;
+    }
+
+    std::size_t size() const
+    {
+        return numElems;
+    }
+
+    // 实际占用的字节数
+    std::size_t bytes() const
+    {
+        return words.capacity() * sizeof(std::uint64_t);
+    }
+
+    // 依次压入 [first, last)，最后一个元素成为栈顶
+    template<typename It>
+    void push_range(It first, It last)
+    {
+        using Elem = std::remove_cv_t<std::remove_reference_t<decltype(*first)>>;
+        if constexpr (std::is_pointer_v<It> && std::is_same_v<Elem, T> && sizeof(T) == 1 && Bits <= 8) {
+            // 先补齐当前的字，然后整字打包追加到 words，最后处理剩余的元素
+            for (; first != last && numElems % PerWord != 0; ++first) {
+                push(*first);
+            }
+            std::size_t whole = static_cast<std::size_t>(last - first) / PerWord;
+#ifndef NDEBUG
+            // 批量打包只取每个字节的低 Bits 位，与 push() 一样先检查取值范围
+            for (std::size_t k = 0; k < whole * PerWord; ++k) {
+                encode(first[k]);
+            }
+#endif
+            reserveElems(whole * PerWord);
+            std::size_t w = numElems / PerWord;
+            auto p = reinterpret_cast<unsigned char const*>(first);
+            for (std::size_t k = 0; k < whole; ++k, p += PerWord) {
+                words[w + k] = packWord(p);
+            }
+            numElems += whole * PerWord;
+            first += whole * PerWord;
+        }
+        for (; first != last; ++first) {
+            push(*first);
+        }
+    }
+};
+#endif //CXX_TEMPLATES_STACKPACKED_HPP
@@ -0,0 +1,68 @@
+#include "asynclog.hpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+int main()
+{
+    {
+        AsyncLogger log(std::cout);
+        log.print(7.5, "hello", 42);            // 输出：7.5 hello 42
+        log.print('x', 1u, -3LL);
+        // 字符串内容拷贝进记录，缓冲区随后被改写也不影响输出
+        char buffer[16] = "stack buffer";
+        std::string heap = "heap string";
+        log.print(buffer, heap.c_str(), std::string_view(heap).substr(0, 4));
+        buffer[0] = '?';
+        heap.assign("overwritten");
+    }   // 析构时等待后台线程写完所有记录
+
+    // 同一线程交替使用两个 logger：每个 logger 只注册一个环
+    {
+        std::ofstream out("/dev/null");
+        AsyncLogger a(out), b(out);
+        for (int i = 0; i < 100'000; ++i) {
+            (i % 2 == 0 ? a : b).print("alternate", i);
+        }
+        std::cout << "alternating loggers: " << a.ringCount() << " + " << b.ringCount() << " rings\n";
+    }
+
+    // 生产者一侧的延迟：只包含二进制拷贝，不包含格式化和 I/O。
+    // 每次突发写入的记录都能放进环中（每条 64 字节，环 64 KiB），突发之间让后台线程排空，
+    // 因此每次调用都被接受，测到的是记录被接受时的延迟，而不是丢弃或等待的路径
+    constexpr int Burst = 512;
+    constexpr int Bursts = 400;
+    for (Overflow policy : {Overflow::Drop, Overflow::Block}) {
+        std::ofstream out("/dev/null");
+        AsyncLogger log(out, policy);
+        double ns = 0;
+        for (int b = 0; b < Bursts; ++b) {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < Burst; ++i) {
+                log.print("value:", i, i * 0.5);
+            }
+            ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::cout << (policy == Overflow::Drop ? "drop " : "block") << ", bursts that fit the ring: "
+                  << ns / (Burst * Bursts) << " ns/call, dropped " << log.dropped() << '\n';
+    }
+
+    // 持续过载：生产速度超过后台线程格式化的速度。block 测到的是后台线程的吞吐量，
+    // drop 的大部分调用走丢弃路径，这里分别报告被接受的比例
+    constexpr int N = 1'000'000;
+    for (Overflow policy : {Overflow::Drop, Overflow::Block}) {
+        std::ofstream out("/dev/null");
+        AsyncLogger log(out, policy);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < N; ++i) {
+            log.print("value:", i, i * 0.5);
+        }
+        auto ns = std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout << (policy == Overflow::Drop ? "drop " : "block") << ", sustained overload: "
+                  << ns / N << " ns/call, accepted " << N - log.dropped() << " of " << N << '\n';
+    }
+}
@@ -0,0 +1,336 @@
+#ifndef CXX_TEMPLATES_ASYNCLOG_HPP
+#define CXX_TEMPLATES_ASYNCLOG_HPP
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// 延迟打印：调用方只把参数包按二进制拷贝进本线程的环形缓冲区，
+// 格式化和 I/O 由后台线程批量完成。
+// 字符串参数（char const*、char*、std::string_view）的内容拷贝到记录末尾，
+// 因此可以传入栈上或堆上的缓冲区。
+
+// 每条记录的头部：解码函数 + 记录总字节数（含头部和对齐填充）
+struct RecordHeader
+{
+    void (*format)(std::ostream&, unsigned char const*);   // nullptr 表示环尾的填充记录
+    std::uint32_t size;
+};
+
+constexpr std::size_t RecordAlign = 16;
+static_assert(sizeof(RecordHeader) <= RecordAlign);
+
+// 由参数包在编译期决定每个参数在记录中的偏移
+template<typename... Types>
+constexpr auto argOffsets()
+{
+    std::array<std::size_t, sizeof...(Types)> offsets{};
+    std::size_t pos = sizeof(RecordHeader);
+    [[maybe_unused]] std::size_t i = 0;
+    ((pos = (pos + alignof(Types) - 1) / alignof(Types) * alignof(Types),
+      offsets[i++] = pos,
+      pos += sizeof(Types)), ...);
+    return offsets;
+}
+
+template<typename... Types>
+struct ArgLayout
+{
+    static constexpr auto offsets = argOffsets<Types...>();
+    static constexpr std::size_t size = [] {
+        std::size_t end = sizeof(RecordHeader);
+        if constexpr (sizeof...(Types) > 0) {
+            std::size_t const sizes[] = {sizeof(Types)...};
+            end = offsets[sizeof...(Types) - 1] + sizes[sizeof...(Types) - 1];
+        }
+        return (end + RecordAlign - 1) / RecordAlign * RecordAlign;   // 记录按 16 字节对齐
+    }();
+};
+
+// 字符串参数在定长部分只保存内容在记录中的位置和长度
+struct StoredString
+{
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+template<typename T>
+constexpr bool isString = std::is_same_v<T, char const*> || std::is_same_v<T, char*>
+                          || std::is_same_v<T, std::string_view>;
+
+template<typename T>
+using Stored = std::conditional_t<isString<T>, StoredString, T>;
+
+template<typename T>
+T loadArg(unsigned char const* p)
+{
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+template<typename T>
+void formatArg(std::ostream& os, unsigned char const* rec, unsigned char const* p)
+{
+    if constexpr (std::is_same_v<T, StoredString>) {
+        auto s = loadArg<StoredString>(p);
+        os << std::string_view(reinterpret_cast<char const*>(rec + s.offset), s.length);
+    }
+    else {
+        os << loadArg<T>(p);
+    }
+}
+
+// 后台线程使用的解码函数：输出格式与 addspace.cpp 中的 print() 相同
+template<typename... Types, std::size_t... I>
+void formatRecord(std::ostream& os, unsigned char const* rec, std::index_sequence<I...>)
+{
+    using Layout = ArgLayout<Types...>;
+    ((formatArg<Types>(os, rec, rec + Layout::offsets[I]), os << ' '), ...);
+    os << '\n';
+}
+
+template<typename... Types>
+void formatRecord(std::ostream& os, unsigned char const* rec)
+{
+    formatRecord<Types...>(os, rec, std::index_sequence_for<Types...>{});
+}
+
+// 单生产者/单消费者的无锁字节环：生产者是调用线程，消费者是后台线程
+class SpscRing
+{
+public:
+    static constexpr std::size_t Capacity = std::size_t(1) << 16;
+private:
+    static constexpr std::size_t Mask = Capacity - 1;
+    alignas(64) std::atomic<std::size_t> head{0};   // 消费者已读到的位置
+    alignas(64) std::atomic<std::size_t> tail{0};   // 生产者已提交的位置
+    alignas(64) std::size_t cachedHead = 0;         // 生产者缓存的 head，减少跨核读取
+    std::size_t pending = 0;                        // reserve() 后待提交的字节数
+    alignas(64) unsigned char buf[Capacity];
+public:
+    // 预留 n 字节（n 为 RecordAlign 的倍数），空间不足时返回 nullptr
+    unsigned char* reserve(std::size_t n)
+    {
+        std::size_t const t = tail.load(std::memory_order_relaxed);
+        std::size_t const offset = t & Mask;
+        std::size_t const contiguous = Capacity - offset;
+        std::size_t const need = contiguous < n ? contiguous + n : n;
+        if (t + need - cachedHead > Capacity) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t + need - cachedHead > Capacity) {
+                return nullptr;
+            }
+        }
+        pending = need;
+        if (contiguous < n) {
+            // 环尾剩余空间不足，写一条填充记录后回绕到起点
+            RecordHeader pad{nullptr, static_cast<std::uint32_t>(contiguous)};
+            std::memcpy(buf + offset, &pad, sizeof(pad));
+            return buf;
+        }
+        return buf + offset;
+    }
+
+    void commit()
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + pending,
+                   std::memory_order_release);
+    }
+
+    // 消费者：格式化所有已提交的记录，返回处理的记录数
+    std::size_t drain(std::ostream& os)
+    {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        std::size_t const t = tail.load(std::memory_order_acquire);
+        std::size_t count = 0;
+        while (h != t) {
+            unsigned char const* rec = buf + (h & Mask);
+            RecordHeader hdr;
+            std::memcpy(&hdr, rec, sizeof(hdr));
+            if (hdr.format) {
+                hdr.format(os, rec);
+                ++count;
+            }
+            h += hdr.size;
+        }
+        head.store(h, std::memory_order_release);
+        return count;
+    }
+};
+
+// 溢出策略：阻塞等待后台线程腾出空间，或者丢弃并计数
+enum class Overflow { Block, Drop };
+
+class AsyncLogger
+{
+private:
+    std::ostream& os;
+    Overflow policy;
+    std::uint64_t id;                               // 区分先后创建于同一地址的 logger
+    std::mutex ringsMutex;                          // 只在注册新线程和后台排空时使用
+    std::vector<std::unique_ptr<SpscRing>> rings;
+    std::atomic<std::size_t> droppedCount{0};
+    std::atomic<bool> stopping{false};
+    std::thread worker;
+
+    static std::uint64_t nextId()
+    {
+        static std::atomic<std::uint64_t> counter{0};
+        return ++counter;
+    }
+
+    // 每个线程在每个 logger 中只有一个环：最近使用的 logger 直接命中，
+    // 否则在本线程的表中查找，只有第一次使用某个 logger 时才加锁注册新环。
+    // logger 的 id 不会重复，已销毁的 logger 留下的表项不会再被匹配到。
+    SpscRing& localRing()
+    {
+        struct Cache { std::uint64_t owner = 0; SpscRing* ring = nullptr; };
+        thread_local Cache cache;
+        thread_local std::unordered_map<std::uint64_t, SpscRing*> known;
+        if (cache.owner != id) {
+            SpscRing*& ring = known[id];
+            if (ring == nullptr) {
+                std::lock_guard<std::mutex> lock(ringsMutex);
+                rings.push_back(std::make_unique<SpscRing>());
+                ring = rings.back().get();
+            }
+            cache = Cache{id, ring};
+        }
+        return *cache.ring;
+    }
+
+    std::size_t drainAll()
+    {
+        std::size_t count = 0;
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        for (auto& r : rings) {
+            count += r->drain(os);
+        }
+        if (count != 0) {
+            os.flush();                             // 每批只刷新一次
+        }
+        return count;
+    }
+
+    void run()
+    {
+        while (!stopping.load(std::memory_order_acquire)) {
+            if (drainAll() == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+        drainAll();
+    }
+public:
+    explicit AsyncLogger(std::ostream& out, Overflow p = Overflow::Drop)
+        : os(out), policy(p), id(nextId()), worker([this] { run(); })
+    {}
+
+    AsyncLogger(AsyncLogger const&) = delete;
+    AsyncLogger& operator=(AsyncLogger const&) = delete;
+
+    ~AsyncLogger()
+    {
+        stopping.store(true, std::memory_order_release);
+        worker.join();
+    }
+
+    // 只接受可按位拷贝的参数；其他指针只按地址输出，字符串参数拷贝内容
+    template<typename... Args>
+    void print(Args... args)
+    {
+        static_assert((std::is_trivially_copyable_v<Args> && ...),
+                      "deferred print() copies arguments bitwise");
+        static_assert(((alignof(Args) <= RecordAlign) && ...));
+        using Layout = ArgLayout<Stored<Args>...>;
+        static_assert(Layout::size <= SpscRing::Capacity / 4);
+
+        // 字符串内容放在定长部分之后，总长度超过环的四分之一时截断
+        std::size_t textSize = 0;
+        ((textSize += textLength(args)), ...);
+        textSize = std::min(textSize, SpscRing::Capacity / 4);
+        std::size_t const size = Layout::size + (textSize + RecordAlign - 1) / RecordAlign * RecordAlign;
+
+        SpscRing& ring = localRing();
+        unsigned char* rec = ring.reserve(size);
+        while (!rec) {
+            if (policy == Overflow::Drop) {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+            rec = ring.reserve(size);
+        }
+        RecordHeader hdr{&formatRecord<Stored<Args>...>, static_cast<std::uint32_t>(size)};
+        std::memcpy(rec, &hdr, sizeof(hdr));
+        std::size_t text = Layout::size;
+        store<Layout>(rec, text, Layout::size + textSize, std::index_sequence_for<Args...>{}, args...);
+        ring.commit();
+    }
+
+    std::size_t dropped() const
+    {
+        return droppedCount.load(std::memory_order_relaxed);
+    }
+
+    // 已注册的环的个数，即使用过这个 logger 的线程数
+    std::size_t ringCount()
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        return rings.size();
+    }
+private:
+    template<typename T>
+    static std::size_t textLength(T const& arg)
+    {
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            return arg.size();
+        }
+        else if constexpr (isString<T>) {
+            return arg != nullptr ? std::strlen(arg) : 0;
+        }
+        else {
+            return 0;
+        }
+    }
+
+    // 普通参数按位拷贝到固定偏移；字符串把内容拷贝到 text 处（不超过 end），定长部分记录位置
+    template<typename Layout, typename T>
+    static void storeArg(unsigned char* rec, std::size_t offset, std::size_t& text, std::size_t end,
+                         T const& arg)
+    {
+        if constexpr (isString<T>) {
+            std::size_t n = std::min(textLength(arg), end - text);
+            if (n != 0) {
+                std::memcpy(rec + text, std::string_view(arg).data(), n);
+            }
+            StoredString s{static_cast<std::uint32_t>(text), static_cast<std::uint32_t>(n)};
+            std::memcpy(rec + offset, &s, sizeof(s));
+            text += n;
+        }
+        else {
+            std::memcpy(rec + offset, &arg, sizeof(T));
+        }
+    }
+
+    template<typename Layout, std::size_t... I, typename... Args>
+    static void store(unsigned char* rec, std::size_t& text, std::size_t end,
+                      std::index_sequence<I...>, Args const&... args)
+    {
+        (storeArg<Layout>(rec, Layout::offsets[I], text, end, args), ...);
+    }
+};
+#endif //CXX_TEMPLATES_ASYNCLOG_HPP
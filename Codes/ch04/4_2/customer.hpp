@@ -0,0 +1,76 @@
+#ifndef CXX_TEMPLATES_CUSTOMER_HPP
+#define CXX_TEMPLATES_CUSTOMER_HPP
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include "stringpool.hpp"
+
+// 与 varusing.cpp 中的 Customer 相同，但 getName() 返回引用，哈希和比较时不再拷贝字符串
+class Customer
+{
+private:
+    std::string name;
+public:
+    Customer(std::string const& n) : name(n){}
+    std::string const& getName() const { return name;}
+};
+
+// 透明的哈希和比较：可以直接用 std::string_view 查找，无需构造 Customer
+struct CustomerHash
+{
+    using is_transparent = void;
+    std::size_t operator()(std::string_view name) const
+    {
+        return std::hash<std::string_view>()(name);
+    }
+    std::size_t operator()(Customer const& c) const
+    {
+        return (*this)(std::string_view(c.getName()));
+    }
+};
+
+struct CustomerEq
+{
+    using is_transparent = void;
+    bool operator()(Customer const& c1, Customer const& c2) const
+    {
+        return c1.getName() == c2.getName();
+    }
+    bool operator()(Customer const& c, std::string_view name) const
+    {
+        return c.getName() == name;
+    }
+    bool operator()(std::string_view name, Customer const& c) const
+    {
+        return c.getName() == name;
+    }
+};
+
+// 名字驻留在 StringPool 中的 Customer：大量重名时只保存一份字符串，
+// 比较变成指针比较，哈希直接读取预计算的值
+class InternedCustomer
+{
+private:
+    Symbol name;
+public:
+    InternedCustomer(StringPool& pool, std::string_view n) : name(pool.intern(n)){}
+    Symbol getName() const { return name;}
+};
+
+struct InternedCustomerHash
+{
+    std::size_t operator()(InternedCustomer const& c) const
+    {
+        return c.getName().hash();
+    }
+};
+
+struct InternedCustomerEq
+{
+    bool operator()(InternedCustomer const& c1, InternedCustomer const& c2) const
+    {
+        return c1.getName() == c2.getName();
+    }
+};
+#endif //CXX_TEMPLATES_CUSTOMER_HPP
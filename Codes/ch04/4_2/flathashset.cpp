@@ -0,0 +1,88 @@
+#include "customer.hpp"
+#include "flathashset.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// varusing.cpp 中的写法：按值返回名字，每次哈希和比较都拷贝字符串
+struct CopyingCustomerEq
+{
+    bool operator()(Customer const& c1, Customer const& c2) const
+    {
+        return std::string(c1.getName()) == std::string(c2.getName());
+    }
+};
+
+struct CopyingCustomerHash
+{
+    std::size_t operator()(Customer const& c) const
+    {
+        return std::hash<std::string>()(std::string(c.getName()));
+    }
+};
+
+template<typename... Bases>
+struct Overloader : Bases...
+{
+    using Bases::operator()...;
+};
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename Set, typename Lookup>
+void bench(char const* title, std::vector<std::string> const& names, Lookup lookup)
+{
+    Set coll;
+    double insertMs = measure([&] {
+        for (auto const& n : names) {
+            coll.insert(Customer(n));
+        }
+    });
+    std::size_t found = 0;
+    double findMs = measure([&] {
+        for (auto const& n : names) {
+            found += lookup(coll, n);
+        }
+    });
+    std::cout << title << ": insert " << insertMs << " ms, find "
+              << findMs << " ms (" << found << " found)\n";
+}
+
+int main()
+{
+    FlatHashSet<Customer, CustomerHash, CustomerEq> coll;
+    coll.insert(Customer("nico"));
+    coll.insert(Customer("david"));
+    std::cout << std::boolalpha
+              << coll.contains(std::string_view("nico")) << ' '   // true，不构造 Customer
+              << coll.contains(std::string_view("doug")) << '\n'; // false
+
+    // 1M 个客户：与 varusing.cpp 中的 coll1/coll2 比较
+    constexpr std::size_t N = 1'000'000;
+    std::vector<std::string> names;
+    names.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        names.push_back("customer-with-a-long-name-" + std::to_string(i));
+    }
+
+    using CustomerOP = Overloader<CopyingCustomerHash, CopyingCustomerEq>;
+    bench<std::unordered_set<Customer, CopyingCustomerHash, CopyingCustomerEq>>(
+        "coll1 (unordered_set)  ", names,
+        [](auto const& s, std::string const& n) { return s.count(Customer(n)); });
+    bench<std::unordered_set<Customer, CustomerOP, CustomerOP>>(
+        "coll2 (Overloader)     ", names,
+        [](auto const& s, std::string const& n) { return s.count(Customer(n)); });
+    bench<FlatHashSet<Customer, CustomerHash, CustomerEq>>(
+        "FlatHashSet/string_view", names,
+        [](auto const& s, std::string const& n) { return s.contains(std::string_view(n)); });
+}
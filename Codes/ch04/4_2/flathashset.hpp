@@ -0,0 +1,291 @@
+#ifndef CXX_TEMPLATES_FLATHASHSET_HPP
+#define CXX_TEMPLATES_FLATHASHSET_HPP
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// SwissTable 风格的开放寻址哈希集合：
+// 每 16 个槽位一组，控制字节保存哈希的低 7 位，一次比较整组；
+// 槽位中缓存完整哈希，扩容时无需重新计算。
+// Hash 和 Eq 若带有 is_transparent，则 find()/contains()/erase() 可用其他键类型查找。
+template<typename T, typename Hash, typename Eq>
+class FlatHashSet
+{
+private:
+    static constexpr std::size_t GroupSize = 16;
+    static constexpr std::int8_t Empty = -128;      // 0b10000000
+    static constexpr std::int8_t Deleted = -2;      // 0b11111110
+
+    struct Slot
+    {
+        std::size_t hash;
+        T value;
+    };
+
+    // 一组 16 个控制字节，返回匹配位置的位掩码
+    struct Group
+    {
+        std::int8_t const* ctrl;
+#ifdef __SSE2__
+        std::uint32_t match(std::int8_t h2) const
+        {
+            __m128i g = _mm_load_si128(reinterpret_cast<__m128i const*>(ctrl));
+            return static_cast<std::uint32_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), g)));
+        }
+        std::uint32_t matchEmptyOrDeleted() const
+        {
+            // Empty 和 Deleted 都小于 -1，而满槽位的控制字节为 0..127
+            __m128i g = _mm_load_si128(reinterpret_cast<__m128i const*>(ctrl));
+            return static_cast<std::uint32_t>(
+                _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), g)));
+        }
+#else
+        std::uint32_t match(std::int8_t h2) const
+        {
+            std::uint32_t mask = 0;
+            for (std::size_t i = 0; i < GroupSize; ++i) {
+                mask |= std::uint32_t(ctrl[i] == h2) << i;
+            }
+            return mask;
+        }
+        std::uint32_t matchEmptyOrDeleted() const
+        {
+            std::uint32_t mask = 0;
+            for (std::size_t i = 0; i < GroupSize; ++i) {
+                mask |= std::uint32_t(ctrl[i] < -1) << i;
+            }
+            return mask;
+        }
+#endif
+        std::uint32_t matchEmpty() const
+        {
+            return match(Empty);
+        }
+    };
+
+    struct CtrlDeleter
+    {
+        void operator()(std::int8_t* p) const
+        {
+            ::operator delete[](p, std::align_val_t(GroupSize));
+        }
+    };
+
+    std::unique_ptr<std::int8_t[], CtrlDeleter> ctrl;
+    Slot* slots = nullptr;
+    std::size_t numGroups = 0;
+    std::size_t count = 0;
+    std::size_t growthLeft = 0;
+    Hash hasher;
+    Eq equal;
+
+    static std::size_t mix(std::size_t h)
+    {
+        // 让质量一般的哈希（如整数恒等哈希）的高低位都参与寻址
+        std::uint64_t x = static_cast<std::uint64_t>(h) * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(x ^ (x >> 32));
+    }
+    static std::int8_t h2(std::size_t h) { return static_cast<std::int8_t>(h & 0x7F); }
+    static std::size_t h1(std::size_t h) { return h >> 7; }
+    static int lowestBit(std::uint32_t mask) { return __builtin_ctz(mask); }
+
+    std::size_t capacity() const { return numGroups * GroupSize; }
+
+    template<typename K>
+    Slot* findSlot(K const& key, std::size_t h) const
+    {
+        if (numGroups == 0) {
+            return nullptr;
+        }
+        std::size_t g = h1(h) & (numGroups - 1);
+        for (std::size_t step = 1; ; ++step) {
+            Group grp{ctrl.get() + g * GroupSize};
+            for (std::uint32_t m = grp.match(h2(h)); m != 0; m &= m - 1) {
+                Slot* s = slots + g * GroupSize + lowestBit(m);
+                if (s->hash == h && equal(s->value, key)) {
+                    return s;
+                }
+            }
+            if (grp.matchEmpty() != 0) {
+                return nullptr;
+            }
+            g = (g + step) & (numGroups - 1);       // 三角数探测，能访问到所有组
+        }
+    }
+
+    std::size_t findInsertPos(std::size_t h) const
+    {
+        std::size_t g = h1(h) & (numGroups - 1);
+        for (std::size_t step = 1; ; ++step) {
+            std::uint32_t m = Group{ctrl.get() + g * GroupSize}.matchEmptyOrDeleted();
+            if (m != 0) {
+                return g * GroupSize + lowestBit(m);
+            }
+            g = (g + step) & (numGroups - 1);
+        }
+    }
+
+    void rehash(std::size_t newGroups)
+    {
+        FlatHashSet tmp(hasher, equal);
+        tmp.allocate(newGroups);
+        for (std::size_t i = 0; i < capacity(); ++i) {
+            if (ctrl[i] >= 0) {
+                tmp.insertUnique(slots[i].hash, std::move(slots[i].value));
+            }
+        }
+        swap(tmp);
+    }
+
+    void allocate(std::size_t groups)
+    {
+        numGroups = groups;
+        ctrl.reset(static_cast<std::int8_t*>(
+            ::operator new[](capacity(), std::align_val_t(GroupSize))));
+        std::memset(ctrl.get(), Empty, capacity());
+        slots = std::allocator<Slot>().allocate(capacity());
+        growthLeft = capacity() / 8 * 7;            // 最大装载因子 7/8
+    }
+
+    void insertUnique(std::size_t h, T&& value)
+    {
+        std::size_t pos = findInsertPos(h);
+        if (ctrl[pos] == Empty) {
+            --growthLeft;
+        }
+        ::new (static_cast<void*>(&slots[pos])) Slot{h, std::move(value)};
+        ctrl[pos] = h2(h);
+        ++count;
+    }
+
+    void destroy()
+    {
+        for (std::size_t i = 0; i < capacity(); ++i) {
+            if (ctrl[i] >= 0) {
+                slots[i].~Slot();
+            }
+        }
+        if (slots) {
+            std::allocator<Slot>().deallocate(slots, capacity());
+        }
+    }
+public:
+    explicit FlatHashSet(Hash const& h = Hash(), Eq const& e = Eq())
+        : hasher(h), equal(e)
+    {}
+
+    FlatHashSet(FlatHashSet const&) = delete;
+    FlatHashSet& operator=(FlatHashSet const&) = delete;
+
+    FlatHashSet(FlatHashSet&& other) noexcept
+        : hasher(other.hasher), equal(other.equal)
+    {
+        swap(other);
+    }
+
+    FlatHashSet& operator=(FlatHashSet&& other) noexcept
+    {
+        FlatHashSet tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    ~FlatHashSet()
+    {
+        destroy();
+    }
+
+    void swap(FlatHashSet& other) noexcept
+    {
+        using std::swap;
+        swap(ctrl, other.ctrl);
+        swap(slots, other.slots);
+        swap(numGroups, other.numGroups);
+        swap(count, other.count);
+        swap(growthLeft, other.growthLeft);
+        swap(hasher, other.hasher);
+        swap(equal, other.equal);
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // 预留至少 n 个元素的空间
+    void reserve(std::size_t n)
+    {
+        std::size_t groups = 1;
+        while (groups * GroupSize / 8 * 7 < n) {
+            groups *= 2;
+        }
+        if (groups > numGroups) {
+            rehash(groups);
+        }
+    }
+
+    // 返回是否插入了新元素
+    bool insert(T value)
+    {
+        std::size_t h = mix(hasher(value));
+        if (findSlot(value, h)) {
+            return false;
+        }
+        if (growthLeft == 0) {
+            rehash(numGroups == 0 ? 1 : numGroups * 2);
+        }
+        insertUnique(h, std::move(value));
+        return true;
+    }
+
+    template<typename K>
+    T const* find(K const& key) const
+    {
+        Slot* s = findSlot(key, mix(hasher(key)));
+        return s ? &s->value : nullptr;
+    }
+
+    template<typename K>
+    bool contains(K const& key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    template<typename K>
+    bool erase(K const& key)
+    {
+        Slot* s = findSlot(key, mix(hasher(key)));
+        if (!s) {
+            return false;
+        }
+        std::size_t pos = s - slots;
+        s->~Slot();
+        // 组内还有空位时，探测序列不会越过这一组，可以直接标记为空
+        if (Group{ctrl.get() + pos / GroupSize * GroupSize}.matchEmpty() != 0) {
+            ctrl[pos] = Empty;
+            ++growthLeft;
+        }
+        else {
+            ctrl[pos] = Deleted;
+        }
+        --count;
+        return true;
+    }
+
+    template<typename F>
+    void forEach(F&& f) const
+    {
+        for (std::size_t i = 0; i < capacity(); ++i) {
+            if (ctrl[i] >= 0) {
+                f(slots[i].value);
+            }
+        }
+    }
+};
+#endif //CXX_TEMPLATES_FLATHASHSET_HPP
@@ -0,0 +1,31 @@
+#ifndef CXX_TEMPLATES_NODE_HPP
+#define CXX_TEMPLATES_NODE_HPP
+
+// foldtraverse.cpp 中的二叉树节点
+struct Node
+{
+    int value;
+    Node* left;
+    Node* right;
+    Node(int i = 0) : value(i), left(nullptr), right(nullptr)
+    {}
+};
+
+// 释放 root 为根的整棵树。把左子树逐个右旋上来，不用递归也不用额外的栈，
+// 退化成链表（高度与节点数同阶）的树也能释放
+inline void deleteTree(Node* root)
+{
+    while (root) {
+        if (Node* l = root->left) {
+            root->left = l->right;
+            l->right = root;
+            root = l;
+        }
+        else {
+            Node* r = root->right;
+            delete root;
+            root = r;
+        }
+    }
+}
+#endif //CXX_TEMPLATES_NODE_HPP
@@ -0,0 +1,164 @@
+#include "nodegenerator.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+
+// 统计堆内存峰值：在每块内存前记录大小
+static std::size_t heapCurrent = 0;
+static std::size_t heapPeak = 0;
+
+void* operator new(std::size_t size)
+{
+    auto* p = static_cast<std::size_t*>(std::malloc(size + 16));
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    *p = size;
+    heapCurrent += size;
+    heapPeak = heapCurrent > heapPeak ? heapCurrent : heapPeak;
+    return reinterpret_cast<char*>(p) + 16;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (ptr) {
+        auto* p = reinterpret_cast<std::size_t*>(static_cast<char*>(ptr) - 16);
+        heapCurrent -= *p;
+        std::free(p);
+    }
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+// 对照组：先把整棵树按中序收集到 vector 中
+std::vector<Node*> collectInorder(Node* root)
+{
+    std::vector<Node*> result;
+    std::vector<Node*> stack;
+    for (Node* n = root; n || !stack.empty(); ) {
+        while (n) {
+            stack.push_back(n);
+            n = n->left;
+        }
+        n = stack.back();
+        stack.pop_back();
+        result.push_back(n);
+        n = n->right;
+    }
+    return result;
+}
+
+// 宽树：完全二叉树
+Node* buildWide(int depth, int& next)
+{
+    if (depth == 0) {
+        return nullptr;
+    }
+    Node* n = new Node(next++);
+    n->left = buildWide(depth - 1, next);
+    n->right = buildWide(depth - 1, next);
+    return n;
+}
+
+// 深树：随机的“毛毛虫”，主干很长，每个主干节点挂一个叶子
+Node* buildDeep(int length)
+{
+    std::mt19937 rng(1);
+    Node* root = new Node(0);
+    Node* n = root;
+    for (int i = 1; i < length; ++i) {
+        Node* spine = new Node(2 * i);
+        Node* leaf = new Node(2 * i + 1);
+        if (rng() & 1) {
+            n->left = spine;
+            n->right = leaf;
+        }
+        else {
+            n->left = leaf;
+            n->right = spine;
+        }
+        n = spine;
+    }
+    return root;
+}
+
+void bench(char const* title, Node* root)
+{
+    using Clock = std::chrono::steady_clock;
+    auto us = [](Clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    };
+
+    std::size_t base = heapCurrent;
+    heapPeak = base;
+    auto start = Clock::now();
+    std::vector<Node*> all = collectInorder(root);
+    Node* first = all.front();
+    auto firstEager = Clock::now() - start;
+    long long sumEager = 0;
+    for (Node* n : all) {
+        sumEager += n->value;
+    }
+    auto totalEager = Clock::now() - start;
+    std::size_t peakEager = heapPeak - base;
+    all = std::vector<Node*>();
+
+    heapPeak = base;
+    start = Clock::now();
+    Generator<Node*> gen = inorder(root);
+    auto it = gen.begin();
+    auto firstLazy = Clock::now() - start;
+    bool sameFirst = *it == first;
+    long long sumLazy = 0;
+    for (; it != gen.end(); ++it) {
+        sumLazy += (*it)->value;
+    }
+    auto totalLazy = Clock::now() - start;
+    std::size_t peakLazy = heapPeak - base;
+
+    std::cout << title << (sameFirst && sumEager == sumLazy ? "" : " MISMATCH") << '\n'
+              << "  eager: first " << us(firstEager) << " us, total " << us(totalEager)
+              << " us, peak heap " << peakEager << " bytes\n"
+              << "  lazy:  first " << us(firstLazy) << " us, total " << us(totalLazy)
+              << " us, peak heap " << peakLazy << " bytes\n";
+}
+
+int main()
+{
+    int next = 0;
+    Node* wide = buildWide(4, next);                // 15 个节点
+
+    std::cout << "pre:  ";
+    for (Node* n : preorder(wide)) std::cout << n->value << ' ';
+    std::cout << "\nin:   ";
+    for (Node* n : inorder(wide)) std::cout << n->value << ' ';
+    std::cout << "\npost: ";
+    for (Node* n : postorder(wide)) std::cout << n->value << ' ';
+    std::cout << "\nlevel:";
+    for (Node* n : levelorder(wide)) std::cout << ' ' << n->value;
+    std::cout << '\n';
+
+    // 提前停止：遇到第一个大于 2 的值就退出，协程帧随 Generator 一起销毁
+    for (Node* n : levelorder(wide)) {
+        if (n->value > 2) {
+            break;
+        }
+        std::cout << "level-order prefix: " << n->value << '\n';
+    }
+
+    deleteTree(wide);
+
+    next = 0;
+    Node* big = buildWide(20, next);
+    bench("wide tree (2^20 - 1 nodes)", big);
+    deleteTree(big);
+    big = buildDeep(1 << 19);
+    bench("deep tree (2^20 - 1 nodes, height 2^19)", big);
+    deleteTree(big);
+}
@@ -0,0 +1,185 @@
+#ifndef CXX_TEMPLATES_NODEGENERATOR_HPP
+#define CXX_TEMPLATES_NODEGENERATOR_HPP
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "node.hpp"
+
+// 基于 C++20 协程的惰性遍历（需要 -std=c++20）：
+// 每次只产生一个节点，调用方可以随时停止，不必先把整棵树收集到 std::vector<Node*> 中。
+// 深度优先遍历只保存 O(树高) 的显式栈，层序遍历只保存一层的队列。
+// 这并不是有界的：树高与节点数同阶的深树上，栈与节点数同阶
+// （nodegenerator.cpp 中的深树高 2^19，栈最多约 2^19 项），只是仍然小于收集全部节点的 vector。
+
+template<typename T>
+class Generator
+{
+public:
+    struct promise_type
+    {
+        T current;
+        std::exception_ptr error;
+
+        Generator get_return_object()
+        {
+            return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(T value) noexcept
+        {
+            current = std::move(value);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    class iterator
+    {
+    private:
+        std::coroutine_handle<promise_type> coro;
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator(std::coroutine_handle<promise_type> h = nullptr) : coro(h)
+        {}
+        T const& operator*() const { return coro.promise().current; }
+        iterator& operator++()
+        {
+            coro.resume();
+            if (coro.promise().error) {
+                std::rethrow_exception(coro.promise().error);
+            }
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        friend bool operator==(iterator const& it, std::default_sentinel_t)
+        {
+            return !it.coro || it.coro.done();
+        }
+    };
+private:
+    std::coroutine_handle<promise_type> coro;
+    explicit Generator(std::coroutine_handle<promise_type> h) : coro(h)
+    {}
+public:
+    Generator(Generator&& other) noexcept : coro(std::exchange(other.coro, nullptr))
+    {}
+    Generator& operator=(Generator&& other) noexcept
+    {
+        std::swap(coro, other.coro);
+        return *this;
+    }
+    ~Generator()
+    {
+        if (coro) {
+            coro.destroy();                         // 提前停止时释放协程帧和其中的栈
+        }
+    }
+
+    iterator begin()
+    {
+        iterator it(coro);
+        ++it;                                       // 运行到第一个 co_yield
+        return it;
+    }
+    std::default_sentinel_t end() { return {}; }
+};
+
+// 预取即将访问的子节点：只在 co_yield 之前或入栈/入队时预取，
+// 要等到调用方处理完当前节点（或整棵子树）之后才会访问，预取才能隐藏延迟
+inline void prefetchNode(Node const* n)
+{
+    if (n) {
+        __builtin_prefetch(n);
+    }
+}
+
+inline Generator<Node*> preorder(Node* root)
+{
+    std::vector<Node*> stack;
+    if (root) {
+        stack.push_back(root);
+    }
+    while (!stack.empty()) {
+        Node* n = stack.back();
+        stack.pop_back();
+        prefetchNode(n->left);
+        prefetchNode(n->right);
+        co_yield n;
+        if (n->right) {
+            stack.push_back(n->right);
+        }
+        if (n->left) {
+            stack.push_back(n->left);
+        }
+    }
+}
+
+inline Generator<Node*> inorder(Node* root)
+{
+    std::vector<Node*> stack;
+    Node* n = root;
+    while (n || !stack.empty()) {
+        while (n) {
+            stack.push_back(n);                     // 左子节点紧接着就访问，预取没有意义
+            n = n->left;
+        }
+        n = stack.back();
+        stack.pop_back();
+        prefetchNode(n->right);
+        co_yield n;
+        n = n->right;
+    }
+}
+
+inline Generator<Node*> postorder(Node* root)
+{
+    std::vector<Node*> stack;
+    Node* n = root;
+    Node* last = nullptr;                           // 上一个产生的节点
+    while (n || !stack.empty()) {
+        while (n) {
+            prefetchNode(n->right);
+            stack.push_back(n);
+            n = n->left;
+        }
+        Node* top = stack.back();
+        if (top->right && top->right != last) {
+            n = top->right;                         // 先处理右子树
+        }
+        else {
+            stack.pop_back();
+            last = top;
+            co_yield top;
+        }
+    }
+}
+
+inline Generator<Node*> levelorder(Node* root)
+{
+    std::deque<Node*> queue;
+    if (root) {
+        queue.push_back(root);
+    }
+    while (!queue.empty()) {
+        Node* n = queue.front();
+        queue.pop_front();
+        if (n->left) {
+            prefetchNode(n->left);
+            queue.push_back(n->left);
+        }
+        if (n->right) {
+            prefetchNode(n->right);
+            queue.push_back(n->right);
+        }
+        co_yield n;
+    }
+}
+#endif //CXX_TEMPLATES_NODEGENERATOR_HPP
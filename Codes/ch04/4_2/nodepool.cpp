@@ -0,0 +1,101 @@
+#include "node.hpp"
+#include "nodepool.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+auto left = &Node::left;
+auto right = &Node::right;
+auto pleft = &PoolNode::left;
+auto pright = &PoolNode::right;
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+// 沿随机方向一直走到叶子：每一步都是一次 traverse(np, path)
+template<typename Ref, typename Path>
+long long randomWalks(Ref root, Path const (&dirs)[2], std::size_t walks)
+{
+    std::mt19937 rng(7);
+    long long sum = 0;
+    for (std::size_t w = 0; w < walks; ++w) {
+        Ref np = root;
+        for (unsigned bits = rng(); ; bits >>= 1) {
+            Ref next = traverse(np, dirs[bits & 1]);
+            if (!next) {
+                break;
+            }
+            np = next;
+            if (bits <= 1) {
+                bits = rng() | 0x80000000u;
+            }
+        }
+        sum += np->value;
+    }
+    return sum;
+}
+
+int main(int argc, char* argv[])
+{
+    // 与 foldtraverse.cpp 相同的用法
+    NodePool pool;
+    NodeRef root = pool.ref(pool.create(0));
+    root->left = pool.create(1);
+    pool[root->left].right = pool.create(2);
+    std::cout << "traverse(root, left, right): "
+              << traverse(root, pleft, pright)->value << '\n';
+
+    // 随机插入构造二叉搜索树；节点数可由命令行指定（默认 1M）
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    std::mt19937 rng(42);
+    std::vector<int> keys(n);
+    for (auto& k : keys) {
+        k = static_cast<int>(rng());
+    }
+
+    Node* proot = new Node(keys[0]);
+    NodePool tree(n);
+    NodeIndex troot = tree.create(keys[0]);
+    for (std::size_t i = 1; i < n; ++i) {
+        for (Node* p = proot; ; ) {
+            Node*& child = keys[i] < p->value ? p->left : p->right;
+            if (!child) {
+                child = new Node(keys[i]);
+                break;
+            }
+            p = child;
+        }
+        for (NodeIndex p = troot; ; ) {
+            NodeIndex child = keys[i] < tree[p].value ? tree[p].left : tree[p].right;
+            if (child == nullNode) {
+                child = tree.create(keys[i]);
+                (keys[i] < tree[p].value ? tree[p].left : tree[p].right) = child;
+                break;
+            }
+            p = child;
+        }
+    }
+
+    constexpr std::size_t Walks = 1'000'000;
+    Node* Node::* const dirs[2] = {left, right};
+    NodeIndex PoolNode::* const pdirs[2] = {pleft, pright};
+    long long s1 = 0, s2 = 0, s3 = 0;
+    double ptrMs = measure([&] { s1 = randomWalks(proot, dirs, Walks); });
+    double poolMs = measure([&] { s2 = randomWalks(tree.ref(troot), pdirs, Walks); });
+    troot = tree.relayoutBreadthFirst(troot);
+    double bfsMs = measure([&] { s3 = randomWalks(tree.ref(troot), pdirs, Walks); });
+    std::cout << n << " nodes, " << Walks << " random root-to-leaf walks\n"
+              << "new Node / pointers:       " << ptrMs << " ms\n"
+              << "NodePool / 32-bit links:   " << poolMs << " ms\n"
+              << "NodePool / breadth-first:  " << bfsMs << " ms\n"
+              << (s1 == s2 && s2 == s3 ? "results match\n" : "results differ\n");
+    deleteTree(proot);
+}
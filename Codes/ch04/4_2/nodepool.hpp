@@ -0,0 +1,116 @@
+#ifndef CXX_TEMPLATES_NODEPOOL_HPP
+#define CXX_TEMPLATES_NODEPOOL_HPP
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+// foldtraverse.cpp 中 Node 树的紧凑版本：
+// 所有节点放在一块连续内存中，用 32 位下标代替指针链接（每个节点 12 字节而不是 24 字节）
+
+using NodeIndex = std::uint32_t;
+constexpr NodeIndex nullNode = ~NodeIndex(0);
+
+struct PoolNode
+{
+    int value;
+    NodeIndex left;
+    NodeIndex right;
+};
+
+class NodePool;
+
+// 节点句柄：重载 ->*，使折叠表达式 np ->* ... ->* paths 仍可使用成员指针路径
+class NodeRef
+{
+private:
+    NodePool* pool;
+    NodeIndex index;
+public:
+    NodeRef(NodePool* p = nullptr, NodeIndex i = nullNode) : pool(p), index(i)
+    {}
+    NodeRef operator->*(NodeIndex PoolNode::* link) const;
+    PoolNode* operator->() const;
+    NodeIndex id() const { return index; }
+    explicit operator bool() const { return index != nullNode; }
+};
+
+class NodePool
+{
+private:
+    std::vector<PoolNode> nodes;
+public:
+    explicit NodePool(std::size_t reserve = 0)
+    {
+        nodes.reserve(reserve);
+    }
+
+    NodeIndex create(int value = 0)
+    {
+        assert(nodes.size() < nullNode);
+        nodes.push_back(PoolNode{value, nullNode, nullNode});
+        return static_cast<NodeIndex>(nodes.size() - 1);
+    }
+
+    PoolNode& operator[](NodeIndex i)
+    {
+        return nodes[i];
+    }
+
+    NodeRef ref(NodeIndex i)
+    {
+        return NodeRef(this, i);
+    }
+
+    std::size_t size() const
+    {
+        return nodes.size();
+    }
+
+    // 按广度优先顺序重新排列 root 可达的节点，返回新的根（下标 0）。
+    // 上层节点集中在开头，常被访问的部分留在缓存中；对完全二叉树即为 Eytzinger 布局。
+    // 重排后原来的下标全部失效。
+    NodeIndex relayoutBreadthFirst(NodeIndex root)
+    {
+        if (root == nullNode) {
+            return nullNode;
+        }
+        std::vector<PoolNode> ordered;
+        ordered.reserve(nodes.size());
+        std::vector<NodeIndex> queue;               // 旧下标，按新顺序排列
+        queue.reserve(nodes.size());
+        queue.push_back(root);
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            PoolNode n = nodes[queue[head]];
+            // 子节点在队列中的位置就是它的新下标
+            if (n.left != nullNode) {
+                queue.push_back(n.left);
+                n.left = static_cast<NodeIndex>(queue.size() - 1);
+            }
+            if (n.right != nullNode) {
+                queue.push_back(n.right);
+                n.right = static_cast<NodeIndex>(queue.size() - 1);
+            }
+            ordered.push_back(n);
+        }
+        nodes.swap(ordered);
+        return 0;
+    }
+};
+
+inline NodeRef NodeRef::operator->*(NodeIndex PoolNode::* link) const
+{
+    return NodeRef(pool, (*pool)[index].*link);
+}
+
+inline PoolNode* NodeRef::operator->() const
+{
+    return &(*pool)[index];
+}
+
+// 与 foldtraverse.cpp 中的 traverse() 相同，返回类型由起点决定（Node* 或 NodeRef）
+template<typename T, typename... TP>
+T traverse(T np, TP... paths)
+{
+    return (np ->* ... ->* paths);
+}
+#endif //CXX_TEMPLATES_NODEPOOL_HPP
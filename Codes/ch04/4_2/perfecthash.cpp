@@ -0,0 +1,81 @@
+#include "perfecthash.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// 编译期生成：关键字集合
+constexpr auto keywords = makePerfectHashSet(
+    "template", "typename", "class", "struct", "using", "constexpr",
+    "auto", "decltype", "sizeof", "static_assert", "concept", "requires");
+static_assert(keywords.valid());
+static_assert(keywords.contains("typename"));
+static_assert(!keywords.contains("typedef"));
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+// 运行期构建同一张表，与 std::unordered_set 比较查找吞吐量
+template<std::size_t N>
+void bench()
+{
+    std::vector<std::string> storage;
+    for (std::size_t i = 0; i < N; ++i) {
+        storage.push_back("key-" + std::to_string(i * 7919));
+    }
+    auto keys = std::make_unique<std::array<std::string_view, N>>();
+    for (std::size_t i = 0; i < N; ++i) {
+        (*keys)[i] = storage[i];
+    }
+    auto table = std::make_unique<PerfectHashSet<N>>();
+    if (!table->build(*keys)) {
+        std::cout << N << ": build failed\n";
+        return;
+    }
+    std::unordered_set<std::string_view> coll(keys->begin(), keys->end());
+
+    // 一半命中，一半不命中
+    std::vector<std::string> queries;
+    for (std::size_t i = 0; i < 1'000'000; ++i) {
+        queries.push_back("key-" + std::to_string((i % (2 * N)) * 7919));
+    }
+    std::size_t hits1 = 0, hits2 = 0;
+    double perfect = measure([&] {
+        for (auto const& q : queries) {
+            hits1 += table->contains(q);
+        }
+    });
+    double unordered = measure([&] {
+        for (auto const& q : queries) {
+            hits2 += coll.count(q);
+        }
+    });
+    std::cout << N << " keys: PerfectHashSet " << perfect / queries.size()
+              << " ns/lookup, unordered_set " << unordered / queries.size()
+              << " ns/lookup (" << hits1 << '/' << hits2 << " hits)\n";
+}
+
+int main()
+{
+    std::cout << "slot of \"concept\": " << keywords.find("concept") << '\n';
+
+    // 用作 unordered_set 的哈希函数：bucket 数取 Slots 时没有冲突
+    std::unordered_set<std::string_view, PerfectHashSet<12>::Hasher>
+        kw(PerfectHashSet<12>::Slots, keywords.hasher());
+    kw.insert("template");
+    std::cout << std::boolalpha << (kw.count("template") == 1) << '\n';
+
+    bench<100>();
+    bench<1000>();
+    bench<10000>();
+    bench<100000>();
+}
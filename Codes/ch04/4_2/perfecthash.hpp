@@ -0,0 +1,175 @@
+#ifndef CXX_TEMPLATES_PERFECTHASH_HPP
+#define CXX_TEMPLATES_PERFECTHASH_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// 编译期完美哈希（CHD 风格的 hash-and-displace）：
+// 键先按一次字符串哈希分到桶里，每个桶再找一个位移种子，使桶内所有键落到互不冲突的槽位。
+// 查找 = 一次字符串哈希 + 一次探测 + 一次比较。
+
+constexpr std::uint64_t phHash(std::string_view s)
+{
+    std::uint64_t h = 0xcbf29ce484222325ull;        // FNV-1a
+    for (char c : s) {
+        h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+constexpr std::uint64_t phMix(std::uint64_t h)
+{
+    h ^= h >> 33;                                   // murmur3 finalizer
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    return h ^ (h >> 33);
+}
+
+constexpr std::size_t phCeilPow2(std::size_t n)
+{
+    std::size_t p = 1;
+    while (p < n) {
+        p *= 2;
+    }
+    return p;
+}
+
+template<std::size_t N>
+class PerfectHashSet
+{
+public:
+    static constexpr std::size_t Slots = phCeilPow2(N + N / 4 + 1);    // 装载因子不超过 0.8
+    static constexpr std::size_t Buckets = N / 4 + 1;                  // 平均每桶 4 个键
+    static constexpr std::size_t npos = ~std::size_t(0);
+private:
+    std::array<std::uint32_t, Buckets> seeds{};
+    std::array<std::string_view, Slots> slotKeys{};  // 未使用的槽位 data() 为 nullptr
+    bool ok = false;
+
+    static constexpr std::size_t bucketOf(std::uint64_t h)
+    {
+        return static_cast<std::size_t>(((h >> 32) * Buckets) >> 32);
+    }
+    static constexpr std::size_t slotOf(std::uint64_t h, std::uint32_t seed)
+    {
+        return static_cast<std::size_t>(phMix(h + seed * 0x9E3779B97F4A7C15ull) & (Slots - 1));
+    }
+public:
+    constexpr PerfectHashSet() = default;
+
+    explicit constexpr PerfectHashSet(std::array<std::string_view, N> const& keys)
+    {
+        build(keys);
+    }
+
+    // 构建失败（有重复键或找不到位移种子）时返回 false；既可在编译期也可在运行期调用
+    constexpr bool build(std::array<std::string_view, N> const& keys)
+    {
+        std::array<std::uint64_t, N> hashes{};
+        std::array<std::size_t, Buckets + 1> start{};
+        std::array<std::uint32_t, N> members{};
+        for (std::size_t i = 0; i < N; ++i) {
+            hashes[i] = phHash(keys[i]);
+            ++start[bucketOf(hashes[i]) + 1];
+        }
+        std::size_t maxSize = 0;
+        for (std::size_t b = 0; b < Buckets; ++b) {
+            maxSize = start[b + 1] > maxSize ? start[b + 1] : maxSize;
+            start[b + 1] += start[b];
+        }
+        std::array<std::size_t, Buckets> fill{};
+        for (std::size_t i = 0; i < N; ++i) {
+            std::size_t b = bucketOf(hashes[i]);
+            members[start[b] + fill[b]++] = static_cast<std::uint32_t>(i);
+        }
+
+        std::array<bool, Slots> used{};
+        std::array<std::size_t, 64> tried{};        // 当前桶尝试的槽位，桶大小不会超过 64
+        if (maxSize > tried.size()) {
+            return ok = false;
+        }
+        // 先处理大桶：越晚处理的桶越难找到空位
+        for (std::size_t size = maxSize; size > 0; --size) {
+            for (std::size_t b = 0; b < Buckets; ++b) {
+                if (start[b + 1] - start[b] != size) {
+                    continue;
+                }
+                // 哈希完全相同的两个键不可能被任何种子分开
+                for (std::size_t i = start[b]; i < start[b + 1]; ++i) {
+                    for (std::size_t j = i + 1; j < start[b + 1]; ++j) {
+                        if (hashes[members[i]] == hashes[members[j]]) {
+                            return ok = false;
+                        }
+                    }
+                }
+                std::uint32_t seed = 0;
+                for (;; ++seed) {
+                    if (seed == (1u << 20)) {
+                        return ok = false;
+                    }
+                    std::size_t placed = 0;
+                    for (; placed < size; ++placed) {
+                        std::size_t s = slotOf(hashes[members[start[b] + placed]], seed);
+                        bool clash = used[s];
+                        for (std::size_t j = 0; j < placed && !clash; ++j) {
+                            clash = tried[j] == s;
+                        }
+                        if (clash) {
+                            break;
+                        }
+                        tried[placed] = s;
+                    }
+                    if (placed == size) {
+                        break;
+                    }
+                }
+                seeds[b] = seed;
+                for (std::size_t j = 0; j < size; ++j) {
+                    used[tried[j]] = true;
+                    slotKeys[tried[j]] = keys[members[start[b] + j]];
+                }
+            }
+        }
+        return ok = true;
+    }
+
+    constexpr bool valid() const { return ok; }
+
+    // 返回键所在的槽位（可作为并行数组的下标），不存在时返回 npos
+    constexpr std::size_t find(std::string_view key) const
+    {
+        std::uint64_t h = phHash(key);
+        std::size_t s = slotOf(h, seeds[bucketOf(h)]);
+        std::string_view k = slotKeys[s];
+        return k.data() != nullptr && k == key ? s : npos;
+    }
+
+    constexpr bool contains(std::string_view key) const
+    {
+        return find(key) != npos;
+    }
+
+    // 可直接用作 unordered_set/unordered_map 的哈希函数：对集合内的键没有冲突
+    struct Hasher
+    {
+        PerfectHashSet const* table;
+        constexpr std::size_t operator()(std::string_view key) const
+        {
+            std::uint64_t h = phHash(key);
+            return slotOf(h, table->seeds[bucketOf(h)]);
+        }
+    };
+
+    constexpr Hasher hasher() const { return Hasher{this}; }
+};
+
+// 由字符串字面值推导键的个数：makePerfectHashSet("a", "b", "c")
+template<typename... Strs>
+constexpr auto makePerfectHashSet(Strs const&... strs)
+{
+    return PerfectHashSet<sizeof...(Strs)>(
+        std::array<std::string_view, sizeof...(Strs)>{std::string_view(strs)...});
+}
+#endif //CXX_TEMPLATES_PERFECTHASH_HPP
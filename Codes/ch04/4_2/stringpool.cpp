@@ -0,0 +1,74 @@
+#include "customer.hpp"
+#include "stringpool.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    StringPool pool;
+    Symbol a = pool.intern("nico");
+    Symbol b = pool.intern(std::string("ni") + "co");
+    std::cout << std::boolalpha << (a == b) << ' '              // true：同一个句柄
+              << bool(pool.lookup("david")) << '\n';            // false：尚未驻留
+
+    // 1M 个客户，只有 1000 个不同的名字
+    constexpr std::size_t N = 1'000'000;
+    constexpr std::size_t Distinct = 1000;
+    std::vector<std::string> names;
+    names.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        names.push_back("customer-with-a-long-name-" + std::to_string(i % Distinct));
+    }
+
+    // 多线程并发驻留
+    StringPool customers;
+    std::vector<std::vector<InternedCustomer>> parts(4);
+    double internMs = measure([&] {
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < parts.size(); ++t) {
+            threads.emplace_back([&, t] {
+                for (std::size_t i = t; i < N; i += parts.size()) {
+                    parts[t].emplace_back(customers, names[i]);
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+    });
+    std::cout << "interned " << N << " names into " << customers.size()
+              << " entries in " << internMs << " ms\n";
+
+    std::vector<Customer> plain(names.begin(), names.end());
+    std::unordered_set<Customer, CustomerHash, CustomerEq> coll1;
+    double plainMs = measure([&] {
+        for (auto const& c : plain) {
+            coll1.insert(c);
+        }
+    });
+    std::unordered_set<InternedCustomer, InternedCustomerHash, InternedCustomerEq> coll2;
+    double internedMs = measure([&] {
+        for (auto const& part : parts) {
+            for (auto const& c : part) {
+                coll2.insert(c);
+            }
+        }
+    });
+    std::cout << "unordered_set<Customer>:         " << plainMs << " ms, "
+              << coll1.size() << " distinct\n"
+              << "unordered_set<InternedCustomer>: " << internedMs << " ms, "
+              << coll2.size() << " distinct\n";
+}
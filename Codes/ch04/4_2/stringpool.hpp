@@ -0,0 +1,184 @@
+#ifndef CXX_TEMPLATES_STRINGPOOL_HPP
+#define CXX_TEMPLATES_STRINGPOOL_HPP
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <vector>
+
+// 字符串驻留池：相同内容的字符串只保存一份，并预先计算好哈希值。
+// 已驻留字符串的查找是无锁的；新字符串的插入由互斥量串行化。
+
+class StringPool;
+
+// 驻留字符串的句柄：比较只比较指针，哈希直接读取预计算的值
+class Symbol
+{
+private:
+    struct Entry
+    {
+        std::size_t hash;
+        std::size_t length;
+        char const* chars() const { return reinterpret_cast<char const*>(this + 1); }
+    };
+    Entry const* entry = nullptr;
+    explicit Symbol(Entry const* e) : entry(e) {}
+    friend class StringPool;
+public:
+    Symbol() = default;                     // 空句柄
+    explicit operator bool() const { return entry != nullptr; }
+    std::string_view view() const
+    {
+        return entry ? std::string_view(entry->chars(), entry->length) : std::string_view();
+    }
+    std::size_t hash() const { return entry ? entry->hash : 0; }
+    friend bool operator==(Symbol a, Symbol b) { return a.entry == b.entry; }
+    friend bool operator!=(Symbol a, Symbol b) { return a.entry != b.entry; }
+};
+
+template<>
+struct std::hash<Symbol>
+{
+    std::size_t operator()(Symbol s) const { return s.hash(); }
+};
+
+class StringPool
+{
+private:
+    using Entry = Symbol::Entry;
+
+    // 开放寻址表；扩容时旧表保留到池销毁，正在读旧表的线程仍然安全
+    struct Table
+    {
+        std::size_t mask;
+        std::unique_ptr<std::atomic<Entry const*>[]> slots;
+        explicit Table(std::size_t capacity)
+            : mask(capacity - 1), slots(new std::atomic<Entry const*>[capacity])
+        {
+            for (std::size_t i = 0; i < capacity; ++i) {
+                slots[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    static constexpr std::size_t ChunkSize = 64 * 1024;
+
+    std::atomic<Table*> current;
+    std::mutex writeMutex;                              // 保护以下所有成员
+    std::vector<std::unique_ptr<Table>> tables;
+    std::vector<std::unique_ptr<unsigned char[]>> chunks;
+    std::size_t chunkUsed = ChunkSize;
+    std::size_t count = 0;
+
+    static Entry const* probe(Table const* t, std::string_view s, std::size_t h)
+    {
+        for (std::size_t i = h & t->mask; ; i = (i + 1) & t->mask) {
+            Entry const* e = t->slots[i].load(std::memory_order_acquire);
+            if (!e || (e->hash == h && std::string_view(e->chars(), e->length) == s)) {
+                return e;
+            }
+        }
+    }
+
+    static void place(Table* t, Entry const* e)
+    {
+        std::size_t i = e->hash & t->mask;
+        while (t->slots[i].load(std::memory_order_relaxed)) {
+            i = (i + 1) & t->mask;
+        }
+        t->slots[i].store(e, std::memory_order_release);
+    }
+
+    // 在 arena 中分配一个条目，字符数据紧跟在头部之后
+    Entry const* allocate(std::string_view s, std::size_t h)
+    {
+        std::size_t bytes = (sizeof(Entry) + s.size() + alignof(Entry) - 1)
+                            / alignof(Entry) * alignof(Entry);
+        unsigned char* mem;
+        if (bytes > ChunkSize / 4) {
+            // 大字符串单独分配，不浪费当前块的剩余空间
+            chunks.push_back(std::make_unique<unsigned char[]>(bytes));
+            mem = chunks.back().get();
+        }
+        else {
+            if (chunkUsed + bytes > ChunkSize) {
+                chunks.push_back(std::make_unique<unsigned char[]>(ChunkSize));
+                chunkUsed = 0;
+            }
+            mem = chunks.back().get() + chunkUsed;
+            chunkUsed += bytes;
+        }
+        Entry* e = ::new (mem) Entry{h, s.size()};
+        std::memcpy(e + 1, s.data(), s.size());
+        return e;
+    }
+
+    void grow()
+    {
+        Table* old = current.load(std::memory_order_relaxed);
+        tables.push_back(std::make_unique<Table>((old->mask + 1) * 2));
+        Table* t = tables.back().get();
+        for (std::size_t i = 0; i <= old->mask; ++i) {
+            if (Entry const* e = old->slots[i].load(std::memory_order_relaxed)) {
+                place(t, e);
+            }
+        }
+        current.store(t, std::memory_order_release);
+    }
+public:
+    explicit StringPool(std::size_t expected = 1024)
+    {
+        std::size_t capacity = 16;
+        while (capacity < expected * 2) {
+            capacity *= 2;
+        }
+        tables.push_back(std::make_unique<Table>(capacity));
+        current.store(tables.back().get(), std::memory_order_release);
+    }
+
+    StringPool(StringPool const&) = delete;
+    StringPool& operator=(StringPool const&) = delete;
+
+    // 无锁查找：未驻留时返回空句柄
+    Symbol lookup(std::string_view s) const
+    {
+        return Symbol(probe(current.load(std::memory_order_acquire),
+                            s, std::hash<std::string_view>()(s)));
+    }
+
+    // 返回 s 的驻留句柄，必要时插入
+    Symbol intern(std::string_view s)
+    {
+        std::size_t h = std::hash<std::string_view>()(s);
+        if (Entry const* e = probe(current.load(std::memory_order_acquire), s, h)) {
+            return Symbol(e);
+        }
+        std::lock_guard<std::mutex> lock(writeMutex);
+        // 持锁后重新检查：别的线程可能刚刚插入了同一个字符串
+        if (Entry const* e = probe(current.load(std::memory_order_relaxed), s, h)) {
+            return Symbol(e);
+        }
+        Table* t = current.load(std::memory_order_relaxed);
+        if ((count + 1) * 2 > t->mask + 1) {        // 装载因子不超过 1/2
+            grow();
+            t = current.load(std::memory_order_relaxed);
+        }
+        Entry const* e = allocate(s, h);
+        place(t, e);
+        ++count;
+        return Symbol(e);
+    }
+
+    std::size_t size()
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        return count;
+    }
+};
+#endif //CXX_TEMPLATES_STRINGPOOL_HPP
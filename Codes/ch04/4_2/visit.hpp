@@ -0,0 +1,197 @@
+#ifndef CXX_TEMPLATES_VISIT_HPP
+#define CXX_TEMPLATES_VISIT_HPP
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// 基于 Overloader 的 variant 访问。
+//   fastVisit(f, v...)：所有 variant 的下标合成一个扁平下标，查一张 constexpr 函数指针表，
+//                      只做一次间接调用；单个 variant 且备选类型不超过 SwitchLimit 个时
+//                      直接用 switch，编译器生成跳转表，各分支可以内联，不经过函数指针。
+//   visitIndexed(f, v)：按下标分派，f 以 (std::integral_constant<std::size_t, I>, 值) 调用，
+//                       适用于多个备选类型相同、只能靠下标区分的 variant。
+// 和 std::visit 一样，所有分支的返回类型必须相同，valueless 的 variant 抛出 std::bad_variant_access。
+
+// 定义类：对可变基类的 operator() 进行组合
+template<typename... Bases>
+struct Overloader : Bases...
+{
+    using Bases::operator()...;     // 自 C++ 17 开始 OK
+
+    template<typename... Variants>
+    decltype(auto) visit(Variants&&... vs) const&;
+};
+
+template<typename... Bases>
+Overloader(Bases...) -> Overloader<Bases...>;
+
+namespace visitdetail {
+
+constexpr std::size_t SwitchLimit = 16;
+
+template<typename V>
+constexpr std::size_t size = std::variant_size_v<std::remove_reference_t<V>>;
+
+// 与 std::get 相同，但不检查下标：调用者已经用 index() 选好了分支，
+// 告诉编译器 get_if 不会返回空指针，它内部的下标比较就被优化掉了
+template<std::size_t I, typename V>
+constexpr decltype(auto) unchecked(V&& v)
+{
+    auto* p = std::get_if<I>(&v);
+    if (p == nullptr) {
+        __builtin_unreachable();
+    }
+    if constexpr (std::is_lvalue_reference_v<V>) {
+        return *p;
+    }
+    else {
+        return std::move(*p);
+    }
+}
+
+template<std::size_t I, typename V>
+using AltRef = decltype(std::get<I>(std::declval<V>()));
+
+template<typename F, typename... Vs>
+using Result = std::invoke_result_t<F, AltRef<0, Vs>...>;
+
+// 扁平下标 flat 拆成每个 variant 的下标，最后一个 variant 变化最快
+template<std::size_t Flat, typename... Vs>
+constexpr auto split()
+{
+    constexpr std::size_t n = sizeof...(Vs);
+    std::array<std::size_t, n> sizes{size<Vs>...};
+    std::array<std::size_t, n> idx{};
+    std::size_t rest = Flat;
+    for (std::size_t k = n; k-- > 0;) {
+        idx[k] = rest % sizes[k];
+        rest /= sizes[k];
+    }
+    return idx;
+}
+
+template<std::size_t Flat, typename R, typename F, typename... Vs, std::size_t... K>
+constexpr R dispatchImpl(F&& f, std::index_sequence<K...>, Vs&&... vs)
+{
+    constexpr auto idx = split<Flat, Vs...>();
+    return std::forward<F>(f)(unchecked<idx[K]>(std::forward<Vs>(vs))...);
+}
+
+template<std::size_t Flat, typename R, typename F, typename... Vs>
+constexpr R dispatch(F&& f, Vs&&... vs)
+{
+    return dispatchImpl<Flat, R>(std::forward<F>(f), std::index_sequence_for<Vs...>{},
+                                 std::forward<Vs>(vs)...);
+}
+
+template<typename R, typename F, typename... Vs, std::size_t... Flat>
+constexpr auto makeTable(std::index_sequence<Flat...>)
+{
+    return std::array<R (*)(F&&, Vs&&...), sizeof...(Flat)>{&dispatch<Flat, R, F, Vs...>...};
+}
+
+template<typename R, typename F, typename... Vs>
+constexpr auto table = makeTable<R, F, Vs...>(std::make_index_sequence<(size<Vs> * ... * 1)>{});
+
+template<std::size_t I, typename R, typename F, typename V>
+constexpr R switchCase(F&& f, V&& v)
+{
+    if constexpr (I < size<V>) {
+        return std::forward<F>(f)(unchecked<I>(std::forward<V>(v)));
+    }
+    else {
+        __builtin_unreachable();        // 调用者已经排除了 valueless，下标一定小于 size<V>
+    }
+}
+
+// 单个 variant：真正的 switch，编译器生成一张跳转表，各分支都可以内联
+template<typename R, typename F, typename V>
+constexpr R switchVisit(std::size_t i, F&& f, V&& v)
+{
+    static_assert(size<V> <= SwitchLimit);
+    switch (i) {
+    case 0: return switchCase<0, R>(std::forward<F>(f), std::forward<V>(v));
+    case 1: return switchCase<1, R>(std::forward<F>(f), std::forward<V>(v));
+    case 2: return switchCase<2, R>(std::forward<F>(f), std::forward<V>(v));
+    case 3: return switchCase<3, R>(std::forward<F>(f), std::forward<V>(v));
+    case 4: return switchCase<4, R>(std::forward<F>(f), std::forward<V>(v));
+    case 5: return switchCase<5, R>(std::forward<F>(f), std::forward<V>(v));
+    case 6: return switchCase<6, R>(std::forward<F>(f), std::forward<V>(v));
+    case 7: return switchCase<7, R>(std::forward<F>(f), std::forward<V>(v));
+    case 8: return switchCase<8, R>(std::forward<F>(f), std::forward<V>(v));
+    case 9: return switchCase<9, R>(std::forward<F>(f), std::forward<V>(v));
+    case 10: return switchCase<10, R>(std::forward<F>(f), std::forward<V>(v));
+    case 11: return switchCase<11, R>(std::forward<F>(f), std::forward<V>(v));
+    case 12: return switchCase<12, R>(std::forward<F>(f), std::forward<V>(v));
+    case 13: return switchCase<13, R>(std::forward<F>(f), std::forward<V>(v));
+    case 14: return switchCase<14, R>(std::forward<F>(f), std::forward<V>(v));
+    case 15: return switchCase<15, R>(std::forward<F>(f), std::forward<V>(v));
+    default: __builtin_unreachable();
+    }
+}
+
+template<typename V>
+constexpr bool valueless(V const& v)
+{
+    return v.valueless_by_exception();
+}
+
+} // namespace visitdetail
+
+template<typename F, typename... Variants>
+constexpr decltype(auto) fastVisit(F&& f, Variants&&... vs)
+{
+    using namespace visitdetail;
+    using R = Result<F, Variants...>;
+    if ((valueless(vs) || ...)) {
+        throw std::bad_variant_access();
+    }
+    if constexpr (sizeof...(Variants) == 1 && (size<Variants> * ...) <= SwitchLimit) {
+        return switchVisit<R>(vs.index()..., std::forward<F>(f), std::forward<Variants>(vs)...);
+    }
+    else {
+        std::size_t flat = 0;
+        ((flat = flat * size<Variants> + vs.index()), ...);
+        return table<R, F, Variants...>[flat](std::forward<F>(f), std::forward<Variants>(vs)...);
+    }
+}
+
+namespace visitdetail {
+
+template<std::size_t I, typename R, typename F, typename V>
+constexpr R dispatchIndexed(F&& f, V&& v)
+{
+    return std::forward<F>(f)(std::integral_constant<std::size_t, I>{}, unchecked<I>(std::forward<V>(v)));
+}
+
+template<typename R, typename F, typename V, std::size_t... I>
+constexpr auto makeIndexedTable(std::index_sequence<I...>)
+{
+    return std::array<R (*)(F&&, V&&), sizeof...(I)>{&dispatchIndexed<I, R, F, V>...};
+}
+
+template<typename R, typename F, typename V>
+constexpr auto indexedTable = makeIndexedTable<R, F, V>(std::make_index_sequence<size<V>>{});
+
+} // namespace visitdetail
+
+template<typename F, typename Variant>
+constexpr decltype(auto) visitIndexed(F&& f, Variant&& v)
+{
+    using namespace visitdetail;
+    using R = std::invoke_result_t<F, std::integral_constant<std::size_t, 0>, AltRef<0, Variant>>;
+    if (v.valueless_by_exception()) {
+        throw std::bad_variant_access();
+    }
+    return indexedTable<R, F, Variant>[v.index()](std::forward<F>(f), std::forward<Variant>(v));
+}
+
+template<typename... Bases>
+template<typename... Variants>
+decltype(auto) Overloader<Bases...>::visit(Variants&&... vs) const&
+{
+    return fastVisit(*this, std::forward<Variants>(vs)...);
+}
+#endif //CXX_TEMPLATES_VISIT_HPP
@@ -0,0 +1,113 @@
+#include "visit.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+template<std::size_t I>
+struct Alt
+{
+    int v;
+};
+
+template<std::size_t I>
+struct Handler
+{
+    int operator()(Alt<I> const& a) const { return a.v * static_cast<int>(I + 1); }
+};
+
+template<std::size_t... I>
+auto makeVariantType(std::index_sequence<I...>) -> std::variant<Alt<I>...>;
+
+template<std::size_t... I>
+auto makeHandler(std::index_sequence<I...>) -> Overloader<Handler<I>...>;
+
+template<std::size_t N>
+using Msg = decltype(makeVariantType(std::make_index_sequence<N>{}));
+
+template<std::size_t N, std::size_t... I>
+Msg<N> makeMsg(std::size_t k, int v, std::index_sequence<I...>)
+{
+    Msg<N> m;
+    ((k == I ? (void)(m = Alt<I>{v}) : (void)0), ...);
+    return m;
+}
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+constexpr std::size_t Count = 1 << 14;
+constexpr int Rounds = 64;
+
+// 每个 variant 的下标随机，输出每次访问的纳秒数
+template<std::size_t N, std::size_t K>
+void bench()
+{
+    std::mt19937 rng(N * 10 + K);
+    std::vector<std::array<Msg<N>, K>> msgs(Count);
+    for (auto& ms : msgs) {
+        for (auto& m : ms) {
+            m = makeMsg<N>(rng() % N, static_cast<int>(rng() % 100), std::make_index_sequence<N>{});
+        }
+    }
+    // 两种实现交替运行 5 轮，各取最小值，减小代码对齐和缓存预热带来的偏差
+    auto once = [&](auto visitor, long long& sum) {
+        return measure([&] {
+            for (int r = 0; r < Rounds; ++r) {
+                for (auto& ms : msgs) {
+                    sum += std::apply(visitor, ms);
+                }
+            }
+        }) / (Count * Rounds);
+    };
+    auto run = [&](auto stdVisitor, auto fastVisitor) {
+        double a = 1e300, b = 1e300;
+        long long sa = 0, sb = 0;
+        for (int t = 0; t < 5; ++t) {
+            a = std::min(a, once(stdVisitor, sa));
+            b = std::min(b, once(fastVisitor, sb));
+        }
+        std::cout << N << "\t" << K << "\t" << a << "\t\t" << b
+                  << (sa == sb ? "" : "\tMISMATCH") << '\n';
+    };
+    if constexpr (K == 1) {
+        decltype(makeHandler(std::make_index_sequence<N>{})) h;
+        run([&](auto const& m) { return std::visit(h, m); },
+            [&](auto const& m) { return h.visit(m); });
+    }
+    else {
+        Overloader h{[](auto const&... alts) { return (alts.v + ...); }};
+        run([&](auto const&... ms) { return std::visit(h, ms...); },
+            [&](auto const&... ms) { return fastVisit(h, ms...); });
+    }
+}
+template<std::size_t K, std::size_t... N>
+void benchSizes()
+{
+    (bench<N, K>(), ...);
+}
+
+int main()
+{
+    std::cout << "alternatives\tvariants\tstd::visit ns\tfastVisit ns\n";
+    benchSizes<1, 2, 4, 8, 16, 32, 64>();
+    benchSizes<2, 2, 4, 8, 16, 32, 64>();
+    benchSizes<3, 2, 4, 8, 16>();       // 3 个 64 选 1 的 variant 需要 262144 个分支实例，编译过慢
+
+    // 按下标分派：两个备选类型都是 int
+    std::variant<int, int> v(std::in_place_index<1>, 7);
+    std::cout << "visitIndexed: "
+              << visitIndexed([](auto i, int x) { return i() == 1 ? x : -x; }, v) << '\n';
+}
@@ -0,0 +1,104 @@
+#include "stack.hpp"
+#include "relocvector.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// 只在堆上保存字符的字符串（没有 SSO），移动只是转移指针，因此声明为可平凡重定位
+class String
+{
+private:
+    char* data = nullptr;
+    std::size_t len = 0;
+public:
+    String() = default;
+    explicit String(char const* s) : data(new char[std::strlen(s) + 1]), len(std::strlen(s))
+    {
+        std::memcpy(data, s, len + 1);
+    }
+    String(String const& b) : String(b.data != nullptr ? b.data : "") {}
+    String(String&& b) noexcept : data(std::exchange(b.data, nullptr)), len(std::exchange(b.len, 0)) {}
+    String& operator=(String b) noexcept
+    {
+        std::swap(data, b.data);
+        std::swap(len, b.len);
+        return *this;
+    }
+    ~String() { delete[] data; }
+    std::size_t size() const { return len; }
+};
+
+template<>
+struct is_trivially_relocatable<String> : std::true_type {};
+
+// 相同的布局和行为，但没有声明，走逐个移动构造 + 析构的路径
+struct PlainString : String
+{
+    using String::String;
+};
+
+struct PlainPtr
+{
+    std::unique_ptr<int> p;
+};
+
+static_assert(is_trivially_relocatable_v<String> && !is_trivially_relocatable_v<PlainString>);
+static_assert(is_trivially_relocatable_v<std::unique_ptr<int>> && !is_trivially_relocatable_v<PlainPtr>);
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+// 预先构造好 n 个元素，只计时把它们移入栈（包括所有扩容）的时间，取 5 次中的最小值
+template<template<typename, typename> class Cont, typename T, typename Make>
+double growth(std::size_t n, Make make)
+{
+    double best = 1e300;
+    for (int round = 0; round < 5; ++round) {
+        std::vector<T> src;
+        src.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            src.emplace_back(make(i));
+        }
+        Stack<T, Cont> s;
+        best = std::min(best, measure([&] {
+            for (auto& x : src) {
+                s.push(std::move(x));
+            }
+        }));
+    }
+    return best;
+}
+
+int main()
+{
+    constexpr std::size_t N = 1'000'000;
+    auto str = [](std::size_t) { return "relocatable"; };
+    auto ptr = [](std::size_t i) { return std::make_unique<int>(static_cast<int>(i)); };
+    auto plainPtr = [](std::size_t i) { return PlainPtr{std::make_unique<int>(static_cast<int>(i))}; };
+
+    std::cout << "growth of a stack by " << N << " pushes (ms, best of 5):\n"
+              << "  String      RelocVector memcpy " << growth<RelocVector, String>(N, str)
+              << ", RelocVector loop " << growth<RelocVector, PlainString>(N, str)
+              << ", std::vector " << growth<std::vector, String>(N, str) << '\n'
+              << "  unique_ptr  RelocVector memcpy " << growth<RelocVector, std::unique_ptr<int>>(N, ptr)
+              << ", RelocVector loop " << growth<RelocVector, PlainPtr>(N, plainPtr)
+              << ", std::vector " << growth<std::vector, std::unique_ptr<int>>(N, ptr) << '\n';
+
+    // 转换赋值仍然逐个复制（源栈保持不变），RelocVector 只在 insert 前预留一次空间
+    Stack<int, RelocVector> ints;
+    for (int i = 0; i < 5; ++i) {
+        ints.push(i);
+    }
+    Stack<double, RelocVector> doubles;
+    doubles = ints;
+    std::cout << "converted top: " << doubles.top() << '\n';
+}
@@ -0,0 +1,177 @@
+#ifndef CXX_TEMPLATES_RELOCVECTOR_HPP
+#define CXX_TEMPLATES_RELOCVECTOR_HPP
+#include "../../ch12/12_1/relocatable.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+// 可以作为 Stack 内部容器的动态数组（stack.hpp 的 Cont 参数，或 stack3.hpp 的 Cont 类型）。
+// 与 std::vector 的区别：扩容和 insert 时用 relocate() 搬移元素，
+// 对 is_trivially_relocatable 的类型是一次 memcpy/memmove，而不是逐个移动构造再析构。
+template<typename T, typename Alloc = std::allocator<T>>
+class RelocVector
+{
+private:
+    using Traits = std::allocator_traits<Alloc>;
+    Alloc alloc;
+    T* first = nullptr;
+    std::size_t count = 0;
+    std::size_t cap = 0;
+
+    void grow(std::size_t minCap)
+    {
+        std::size_t newCap = std::max(minCap, cap * 2);
+        T* p = Traits::allocate(alloc, newCap);
+        try {
+            relocate(first, count, p);              // 失败时旧元素保持不变
+        }
+        catch (...) {
+            Traits::deallocate(alloc, p, newCap);
+            throw;
+        }
+        if (first != nullptr) {
+            Traits::deallocate(alloc, first, cap);
+        }
+        first = p;
+        cap = newCap;
+    }
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using iterator = T*;
+    using const_iterator = T const*;
+
+    RelocVector() = default;
+    RelocVector(RelocVector const& b) : alloc(Traits::select_on_container_copy_construction(b.alloc))
+    {
+        insert(end(), b.begin(), b.end());
+    }
+    RelocVector(RelocVector&& b) noexcept
+        : alloc(std::move(b.alloc)), first(std::exchange(b.first, nullptr)),
+          count(std::exchange(b.count, 0)), cap(std::exchange(b.cap, 0))
+    {
+    }
+    RelocVector& operator=(RelocVector b) noexcept
+    {
+        std::swap(first, b.first);
+        std::swap(count, b.count);
+        std::swap(cap, b.cap);
+        return *this;
+    }
+    ~RelocVector()
+    {
+        clear();
+        if (first != nullptr) {
+            Traits::deallocate(alloc, first, cap);
+        }
+    }
+
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return cap; }
+    T* begin() { return first; }
+    T* end() { return first + count; }
+    T const* begin() const { return first; }
+    T const* end() const { return first + count; }
+    T* data() { return first; }
+    T const* data() const { return first; }
+    T& back() { return first[count - 1]; }
+    T const& back() const { return first[count - 1]; }
+
+    void reserve(std::size_t n)
+    {
+        if (n > cap) {
+            grow(n);
+        }
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (count == cap) {
+            // 先在新存储中构造新元素，再搬移旧元素：args 可能引用旧元素
+            std::size_t newCap = std::max<std::size_t>(1, cap * 2);
+            T* p = Traits::allocate(alloc, newCap);
+            try {
+                Traits::construct(alloc, p + count, std::forward<Args>(args)...);
+            }
+            catch (...) {
+                Traits::deallocate(alloc, p, newCap);
+                throw;
+            }
+            try {
+                relocate(first, count, p);
+            }
+            catch (...) {
+                Traits::destroy(alloc, p + count);
+                Traits::deallocate(alloc, p, newCap);
+                throw;
+            }
+            if (first != nullptr) {
+                Traits::deallocate(alloc, first, cap);
+            }
+            first = p;
+            cap = newCap;
+        }
+        else {
+            Traits::construct(alloc, first + count, std::forward<Args>(args)...);
+        }
+        return first[count++];
+    }
+
+    void push_back(T const& elem) { emplace_back(elem); }
+    void push_back(T&& elem) { emplace_back(std::move(elem)); }
+
+    void pop_back()
+    {
+        assert(count != 0);
+        Traits::destroy(alloc, first + --count);
+    }
+
+    void clear()
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            Traits::destroy(alloc, first + i);
+        }
+        count = 0;
+    }
+
+    // 在 pos 处插入 [b, e)：先把区间构造在尾部的空闲位置，再把 pos 之后的元素整体后移
+    template<typename InputIt>
+    T* insert(T const* pos, InputIt b, InputIt e)
+    {
+        std::size_t at = static_cast<std::size_t>(pos - first);
+        std::size_t old = count;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIt>::iterator_category>) {
+            reserve(count + static_cast<std::size_t>(std::distance(b, e)));
+        }
+        for (; b != e; ++b) {
+            emplace_back(*b);
+        }
+        std::size_t n = count - old;
+        if (n != 0 && at != old) {
+            if constexpr (is_nothrow_relocatable_v<T>) {
+                // 把新元素暂存到额外的存储中，后移 [at, old)，再把新元素放回 at
+                T* tmp = Traits::allocate(alloc, n);
+                relocate(first + old, n, tmp);
+                relocateOverlapping(first + at, old - at, first + at + n);
+                relocate(tmp, n, first + at);
+                Traits::deallocate(alloc, tmp, n);
+            }
+            else {
+                // 移动可能抛出异常：只在活对象之间轮换，抛出时所有元素仍然有效（基本保证）
+                std::rotate(first + at, first + old, first + count);
+            }
+        }
+        return first + at;
+    }
+};
+#endif //CXX_TEMPLATES_RELOCVECTOR_HPP
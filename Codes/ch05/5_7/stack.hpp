@@ -1,6 +1,15 @@
+#include "stacksegments.hpp"
 #include <deque>
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <utility>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
 
 template <typename T,
           template <typename Elem,
@@ -12,12 +21,43 @@ private:
     Cont<T> elems; // 元素
 public:
     void push(T const &);
+    void push(T &&);
     void pop();
     T const &top() const;
     bool empty() const
     {
         return elems.empty();
     }
+    std::size_t size() const
+    {
+        return elems.size();
+    }
+
+    // 只读遍历：begin()/end() 从栈底到栈顶，rbegin()/rend() 从栈顶到栈底
+    using const_iterator = typename Cont<T>::const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    const_iterator begin() const { return elems.begin(); }
+    const_iterator end() const { return elems.end(); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(elems.end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(elems.begin()); }
+
+#if __cplusplus >= 202002L
+    // 连续存放的容器（vector、RelocVector）：整个栈作为一个 span，下标 0 是栈底
+    std::span<T const> view() const
+    {
+        static_assert(stackdetail::isContiguous<Cont<T>>, "view() requires a contiguous container");
+        return std::span<T const>(elems.data(), elems.size());
+    }
+#endif
+
+    // 分段遍历：从栈底到栈顶，对每个连续存放的段调用 f(T const* first, T const* last)；
+    // vector 只有一段，deque 每个块一段，算法可以在段内批量（向量化）处理
+    template <typename F>
+    void forEachSegment(F f) const
+    {
+        stackdetail::forEachSegment<T>(elems, f);
+    }
+
     template <typename T2,
               template<typename Elem2,
                        typename Alloc = std::allocator<Elem2>> class Cont2>
@@ -32,6 +72,12 @@ void Stack<T, Cont>::push(T const &elem)
     elems.push_back(elem); // 插入传递的 elem 拷贝
 }
 
+template <typename T, template<typename, typename> class Cont>
+void Stack<T, Cont>::push(T &&elem)
+{
+    elems.push_back(std::move(elem)); // 移入传递的 elem
+}
+
 template <typename T, template <typename, typename> class Cont>
 void Stack<T, Cont>::pop()
 {
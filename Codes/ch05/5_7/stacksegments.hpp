@@ -0,0 +1,78 @@
+#ifndef CXX_TEMPLATES_STACKSEGMENTS_HPP
+#define CXX_TEMPLATES_STACKSEGMENTS_HPP
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// 各个 Stack 的 forEachSegment() 共用的实现：stack.hpp、ch02 的 stack2.hpp 和 stack3.hpp
+namespace stackdetail {
+
+// 有 data() 的容器元素连续存放（vector、RelocVector）
+template <typename C, typename = void>
+constexpr bool isContiguous = false;
+template <typename C>
+constexpr bool isContiguous<C, std::void_t<decltype(std::declval<C const&>().data())>> = true;
+
+template <typename C>
+constexpr bool isDeque = false;
+template <typename T, typename A>
+constexpr bool isDeque<std::deque<T, A>> = true;
+
+// 从 it 开始逐个比较地址，把 it 移到第一个与前一个元素不相邻的位置，返回这一段的尾后地址
+template <typename It>
+auto segmentEnd(It& it, It end)
+{
+    auto const* last = std::addressof(*it) + 1;
+    for (++it; it != end && std::addressof(*it) == last; ++it) {
+        ++last;
+    }
+    return last;
+}
+
+// 按从底到顶的顺序，把容器拆成若干连续的段，对每段调用 f(first, last)
+template <typename T, typename C, typename F>
+void forEachSegment(C const& c, F& f)
+{
+    if constexpr (isContiguous<C>) {
+        if (!c.empty()) {
+            f(c.data(), c.data() + c.size());
+        }
+    }
+    else if constexpr (isDeque<C>) {
+        // deque：除第一块外，每块都从下标为块长整数倍的位置开始，存满 block 个元素。
+        // 前两段逐个比较地址，从第二段得到块长（相邻的块碰巧地址连续时是块长的整数倍，同样可用）；
+        // 之后每段只检查最后一个元素的地址：它与段首相差 step - 1，说明这几块首尾相接，整段连续。
+        // 检查失败或剩余不足一段时退回逐个比较，段的起点始终落在块边界上
+        auto it = c.begin(), end = c.end();
+        std::ptrdiff_t step = 0;
+        for (int scanned = 0; it != end; ) {
+            T const* first = std::addressof(*it);
+            T const* last;
+            if (step != 0 && end - it >= step && std::addressof(it[step - 1]) == first + (step - 1)) {
+                last = first + step;
+                it += step;
+            }
+            else {
+                last = segmentEnd(it, end);
+                if (++scanned == 2 && it != end) {
+                    step = last - first;
+                }
+            }
+            f(first, last);
+        }
+    }
+    else {
+        // 其他容器（list 的单个节点）：只用公开的迭代器，把地址相邻的元素合并成一段
+        auto it = c.begin(), end = c.end();
+        while (it != end) {
+            T const* first = std::addressof(*it);
+            f(first, segmentEnd(it, end));
+        }
+    }
+}
+
+} // namespace stackdetail
+#endif //CXX_TEMPLATES_STACKSEGMENTS_HPP
@@ -0,0 +1,117 @@
+#include "stack.hpp"
+#include "relocvector.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <list>
+#include <numeric>
+#include <span>
+#include <vector>
+
+// 需要 C++20（std::span）：g++ -std=c++20 -O2 stackview.cpp
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+// 原来的做法（见 stackassign.hpp）：拷贝一份，从栈顶逐个弹出
+template<typename S, typename F>
+void copyAndPop(S const& s, F f)
+{
+    S tmp(s);
+    while (!tmp.empty()) {
+        f(tmp.top());
+        tmp.pop();
+    }
+}
+
+template<template<typename, typename> class Cont>
+void bench(char const* name, std::size_t n)
+{
+    Stack<int, Cont> s;
+    for (std::size_t i = 0; i < n; ++i) {
+        s.push(static_cast<int>(i % 1000));
+    }
+    std::vector<long> prefix(n);
+    std::vector<char> buffer(n * sizeof(int));
+
+    // 求和
+    long a = 0, b = 0;
+    double sumOld = measure([&] { copyAndPop(s, [&](int x) { a += x; }); });
+    double sumNew = measure([&] {
+        s.forEachSegment([&](int const* first, int const* last) { b = std::reduce(first, last, b); });
+    });
+
+    // 从栈底开始的前缀和：逐个弹出得到的是逆序，需要先放进数组再反向累加
+    double scanOld = measure([&] {
+        std::size_t i = n;
+        copyAndPop(s, [&](int x) { prefix[--i] = x; });
+        std::partial_sum(prefix.begin(), prefix.end(), prefix.begin());
+    });
+    long lastOld = prefix.back();
+    double scanNew = measure([&] {
+        long carry = 0;
+        long* out = prefix.data();
+        s.forEachSegment([&](int const* first, int const* last) {
+            out = std::inclusive_scan(first, last, out, std::plus<>(), carry);
+            carry = out[-1];
+        });
+    });
+
+    // 序列化：按从底到顶的顺序写入字节缓冲区
+    double serOld = measure([&] {
+        std::size_t i = n;
+        copyAndPop(s, [&](int x) { std::memcpy(buffer.data() + --i * sizeof(int), &x, sizeof(int)); });
+    });
+    double serNew = measure([&] {
+        char* out = buffer.data();
+        s.forEachSegment([&](int const* first, int const* last) {
+            std::memcpy(out, first, (last - first) * sizeof(int));
+            out += (last - first) * sizeof(int);
+        });
+    });
+    int bottom;
+    std::memcpy(&bottom, buffer.data(), sizeof(int));
+
+    bool ok = a == b && lastOld == prefix.back() && bottom == *s.begin() && *s.rbegin() == s.top();
+    std::cout << name << ": sum " << sumOld << " -> " << sumNew << " ms, scan " << scanOld << " -> "
+              << scanNew << " ms, serialize " << serOld << " -> " << serNew << " ms"
+              << (ok ? "" : " (MISMATCH)") << '\n';
+}
+
+int main()
+{
+    // 遍历方向与视图
+    Stack<int, std::vector> vs;
+    for (int i = 1; i <= 5; ++i) {
+        vs.push(i);
+    }
+    std::cout << "bottom-up:";
+    for (int x : vs) {
+        std::cout << ' ' << x;
+    }
+    std::cout << "\ntop-down:";
+    for (auto it = vs.rbegin(); it != vs.rend(); ++it) {
+        std::cout << ' ' << *it;
+    }
+    std::span<int const> sp = vs.view();
+    std::cout << "\nspan of " << sp.size() << ", bottom " << sp.front() << ", top " << sp.back() << '\n';
+
+    Stack<int, std::list> ls;
+    for (int i = 0; i < 3; ++i) {
+        ls.push(i);
+    }
+    int segments = 0;
+    ls.forEachSegment([&](int const*, int const*) { ++segments; });
+    std::cout << "list stack: " << segments << " segments\n";
+
+    constexpr std::size_t n = 10'000'000;
+    bench<std::vector>("vector     ", n);
+    bench<std::deque>("deque      ", n);
+    bench<RelocVector>("RelocVector", n);
+}
@@ -0,0 +1,127 @@
+#include "audited.hpp"
+#include "../../ch02/2_1/stack1.hpp"
+#include "../../ch04/4_1/varprint2.hpp"
+#include "../../ch11/11_1/foreach.hpp"
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// 拷贝路径一旦改变，move_only_audited 会让下面这些用法直接编译失败
+static_assert(!std::is_copy_constructible_v<move_only_audited<std::string>>);
+static_assert(std::is_nothrow_move_constructible_v<audited<int>>);
+
+// invokeret.hpp 中的 call()，省略了 ... 部分；constexpr，以便在编译期审计
+template<typename Callable, typename... Args>
+constexpr decltype(auto) call(Callable&& op, Args&&... args)
+{
+    if constexpr (std::is_same_v<std::invoke_result_t<Callable, Args...>, void>) {
+        std::invoke(std::forward<Callable>(op), std::forward<Args>(args)...);
+        return;
+    }
+    else {
+        decltype(auto) ret{std::invoke(std::forward<Callable>(op), std::forward<Args>(args)...)};
+        return ret;
+    }
+}
+
+#if __cplusplus >= 202002L
+// 编译期预算（g++ -std=c++20）：拷贝次数超出预算时 static_assert 失败，构建直接中断
+using CStr = constexpr_audited<std::string>;
+
+// call() 完美转发：按值接收的参数只移动一次，不拷贝
+static_assert([] {
+    AuditCounts d = auditConstexpr([](AuditCounts& c) {
+        CStr s(c, "moved");
+        call([](CStr v) { return v.get().size(); }, std::move(s));
+    });
+    return d.copies == 0 && d.moves == 1;
+}());
+
+// call() 转发左值：被调用者按 const& 接收，不拷贝
+static_assert(auditConstexpr([](AuditCounts& c) {
+    CStr s(c, "lvalue");
+    call([](CStr const& v) { return v.get().size(); }, s);
+}).copies == 0);
+
+// std::vector 预留空间后 push_back 左值：每个元素恰好一次拷贝，扩容不产生额外的拷贝或移动
+static_assert([] {
+    AuditCounts d = auditConstexpr([](AuditCounts& c) {
+        std::vector<CStr> v;
+        v.reserve(4);
+        CStr s(c, "x");
+        for (int i = 0; i < 4; ++i) {
+            v.push_back(s);
+        }
+    });
+    return d.copies == 4 && d.moves == 0;
+}());
+#endif
+
+int failures = 0;
+
+void check(bool ok, char const* what, AuditCounts const& d)
+{
+    std::cout << (ok ? "PASS " : "FAIL ") << what << " (copies " << d.copies
+              << ", moves " << d.moves << ")\n";
+    failures += !ok;
+}
+
+// 被按值传递的函数对象
+struct AuditedOp
+{
+    AuditTracker<AuditedOp> tracker;
+    void operator()(audited<int> const&) const {}
+};
+
+int main()
+{
+    using Str = audited<std::string>;
+    using Int = audited<int>;
+
+    {   // Stack<T>::push(T const&) 每次拷贝一次，top() 不拷贝
+        Stack<Str> s;
+        Str a("hello");
+        AuditScope<Str> scope;
+        for (int i = 0; i < 10; ++i) {
+            s.push(a);
+        }
+        std::size_t len = s.top().get().size();
+        check(scope.copiesAtMost(10) && len == 5, "Stack: one copy per push, none for top()",
+              scope.delta());
+    }
+
+    {   // foreach()：元素按引用传给 op，op 本身按值传递
+        std::vector<Int> coll(100, Int(1));
+        AuditScope<Int> elems;
+        AuditScope<AuditTracker<AuditedOp>> ops;
+        AuditedOp op;
+        foreach(coll.begin(), coll.end(), op);
+        check(elems.copiesAtMost(0), "foreach: elements are not copied", elems.delta());
+        check(ops.copiesAtMost(1), "foreach: callable copied once", ops.delta());
+    }
+
+    {   // call() 完美转发：只移动，不拷贝
+        move_only_audited<std::string> s("moved");
+        AuditScope<move_only_audited<std::string>> scope;
+        auto len = call([](move_only_audited<std::string> v) { return v.get().size(); },
+                        std::move(s));
+        check(scope.copiesAtMost(0) && scope.movesAtMost(1) && len == 5,
+              "call: perfect forwarding moves once", scope.delta());
+    }
+
+    {   // varprint2.hpp 中的 print() 按值接收参数：每层递归都拷贝
+        // print(a,b,c) 3 次 + print(a) 1 次 + print(b,c) 2 次 + print(b)、print(c) 各 1 次
+        Str a("a"), b("b"), c("c");
+        std::ostringstream out;
+        auto* old = std::cout.rdbuf(out.rdbuf());
+        AuditScope<Str> scope;
+        print(a, b, c);
+        std::cout.rdbuf(old);
+        check(scope.copiesAtMost(8), "print: by-value parameters copy 8 times for 3 args",
+              scope.delta());
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+#ifndef CXX_TEMPLATES_AUDITED_HPP
+#define CXX_TEMPLATES_AUDITED_HPP
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+// 记录构造、拷贝、移动和析构次数的包装类型，用来检查模板实际走的是哪条路径。
+// 三种检查方式：
+//   - audited<T, false>（move_only_audited）删除了拷贝操作：任何拷贝都会在编译期报错；
+//   - constexpr_audited<T> + auditConstexpr()（C++20）：在常量求值中运行一段代码并计数，
+//     用 static_assert 检查“最多 N 次拷贝”，超出预算时编译失败；
+//   - audited<T> + AuditScope：运行期计数。只能用于不能在常量求值中执行的模板，
+//     例如输出到 std::cout 的 print()，以及 stack1.hpp 的 Stack、foreach.hpp 的 foreach：
+//     它们不是 constexpr，而加上 constexpr 会使它们隐式内联，
+//     ch14/14_5/commoninst.hpp 中的显式实例化声明就不再起作用。
+//     这类检查由测试程序的退出码报告，需要作为构建的一步运行。
+
+struct AuditCounts
+{
+    std::size_t constructions = 0;  // 从值构造（非拷贝/移动）
+    std::size_t copies = 0;         // 拷贝构造
+    std::size_t moves = 0;          // 移动构造
+    std::size_t copyAssigns = 0;
+    std::size_t moveAssigns = 0;
+    std::size_t destructions = 0;
+
+    friend AuditCounts operator-(AuditCounts const& a, AuditCounts const& b)
+    {
+        return AuditCounts{a.constructions - b.constructions, a.copies - b.copies,
+                           a.moves - b.moves, a.copyAssigns - b.copyAssigns,
+                           a.moveAssigns - b.moveAssigns, a.destructions - b.destructions};
+    }
+};
+
+// 作为成员放进被审计的类型中，由它的特殊成员函数完成计数
+template<typename Tag>
+class AuditTracker
+{
+public:
+    static AuditCounts& counts()
+    {
+        static thread_local AuditCounts c;          // 每个线程单独计数，互不干扰
+        return c;
+    }
+    AuditTracker() { ++counts().constructions; }
+    AuditTracker(AuditTracker const&) { ++counts().copies; }
+    AuditTracker(AuditTracker&&) noexcept { ++counts().moves; }
+    AuditTracker& operator=(AuditTracker const&) { ++counts().copyAssigns; return *this; }
+    AuditTracker& operator=(AuditTracker&&) noexcept { ++counts().moveAssigns; return *this; }
+    ~AuditTracker() { ++counts().destructions; }
+};
+
+struct AuditCopyable {};
+
+struct AuditMoveOnly
+{
+    AuditMoveOnly() = default;
+    AuditMoveOnly(AuditMoveOnly const&) = delete;
+    AuditMoveOnly(AuditMoveOnly&&) = default;
+    AuditMoveOnly& operator=(AuditMoveOnly const&) = delete;
+    AuditMoveOnly& operator=(AuditMoveOnly&&) = default;
+};
+
+template<typename T, bool Copyable = true>
+class audited;
+
+template<typename T>
+struct IsAudited : std::false_type {};
+
+template<typename T, bool C>
+struct IsAudited<audited<T, C>> : std::true_type {};
+
+// 与 specialmemtmpl.hpp 中的 EnableIfString 相同：避免模板构造函数抢走拷贝/移动构造
+template<typename... Args>
+using EnableIfNotAudited = std::enable_if_t<
+    !(sizeof...(Args) == 1 && (IsAudited<std::decay_t<Args>>::value && ...))>;
+
+template<typename T, bool Copyable>
+class audited : private std::conditional_t<Copyable, AuditCopyable, AuditMoveOnly>
+{
+private:
+    T value;
+    AuditTracker<audited> tracker;
+public:
+    template<typename... Args, typename = EnableIfNotAudited<Args...>>
+    audited(Args&&... args) : value(std::forward<Args>(args)...)
+    {}
+
+    // 全部默认：拷贝/移动 value 的同时由 tracker 计数；基类决定是否允许拷贝
+    audited(audited const&) = default;
+    audited(audited&&) = default;
+    audited& operator=(audited const&) = default;
+    audited& operator=(audited&&) = default;
+
+    T& get() { return value; }
+    T const& get() const { return value; }
+
+    static AuditCounts& counts() { return AuditTracker<audited>::counts(); }
+
+    friend bool operator<(audited const& a, audited const& b) { return a.value < b.value; }
+    friend bool operator==(audited const& a, audited const& b) { return a.value == b.value; }
+    friend std::ostream& operator<<(std::ostream& os, audited const& a) { return os << a.value; }
+};
+
+template<typename T>
+using move_only_audited = audited<T, false>;
+
+// 作用域内的计数增量：AuditScope<audited<std::string>> scope; ...; scope.delta().copies
+template<typename Audited>
+class AuditScope
+{
+private:
+    AuditCounts start;
+public:
+    AuditScope() : start(Audited::counts())
+    {}
+    AuditCounts delta() const { return Audited::counts() - start; }
+    bool copiesAtMost(std::size_t n) const { return delta().copies + delta().copyAssigns <= n; }
+    bool movesAtMost(std::size_t n) const { return delta().moves + delta().moveAssigns <= n; }
+};
+
+#if __cplusplus >= 202002L
+// 编译期审计用的包装类型：计数写入构造时给出的 AuditCounts，拷贝/移动时随值一起传递。
+// 全部成员都是 constexpr，可以在常量求值中使用（C++20 起析构函数也可以是 constexpr）
+template<typename T>
+class constexpr_audited
+{
+private:
+    T value;
+    AuditCounts* sink;
+public:
+    template<typename... Args>
+    constexpr constexpr_audited(AuditCounts& c, Args&&... args)
+        : value(std::forward<Args>(args)...), sink(&c)
+    {
+        ++sink->constructions;
+    }
+    constexpr constexpr_audited(constexpr_audited const& b) : value(b.value), sink(b.sink)
+    {
+        ++sink->copies;
+    }
+    constexpr constexpr_audited(constexpr_audited&& b) noexcept : value(std::move(b.value)), sink(b.sink)
+    {
+        ++sink->moves;
+    }
+    constexpr constexpr_audited& operator=(constexpr_audited const& b)
+    {
+        value = b.value;
+        ++sink->copyAssigns;
+        return *this;
+    }
+    constexpr constexpr_audited& operator=(constexpr_audited&& b) noexcept
+    {
+        value = std::move(b.value);
+        ++sink->moveAssigns;
+        return *this;
+    }
+    constexpr ~constexpr_audited()
+    {
+        ++sink->destructions;
+    }
+
+    constexpr T& get() { return value; }
+    constexpr T const& get() const { return value; }
+};
+
+// 在常量求值中运行 f(counts) 并返回计数：
+//     static_assert(auditConstexpr([](AuditCounts& c) { ... }).copies <= 1);
+template<typename F>
+constexpr AuditCounts auditConstexpr(F f)
+{
+    AuditCounts c;
+    f(c);
+    return c;
+}
+#endif
+#endif //CXX_TEMPLATES_AUDITED_HPP
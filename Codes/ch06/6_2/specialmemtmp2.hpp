@@ -1,6 +1,7 @@
 #include <utility>
 #include <string>
 #include <iostream>
+#include "../6_4/memevents.hpp"
 
 class Person
 {
@@ -12,16 +13,16 @@ public:
     template<typename STR>
     explicit Person(STR&& n) : name(std::forward<STR>(n))
     {
-        std::cout << "TMPL-CONSTR for '" << name << "'\n";
+        memEvent<Person>(MemEvent::TemplateConstruct, name);
     }
     // 拷贝和移动构造(2)
     Person(Person const &p) : name(p.name)
     {
-        std::cout << "COPY-CONSTR Person '" << name << "'\n";
+        memEvent<Person>(MemEvent::Copy, name);
     }
     // (3)
     Person(Person &&p) : name(std::move(p.name))
     {
-        std::cout << "MOVE_CONSTR Person '" << name << "'\n";
+        memEvent<Person>(MemEvent::Move, name);
     }
 };
\ No newline at end of file
@@ -0,0 +1,141 @@
+#ifndef CXX_TEMPLATES_MEMEVENTS_HPP
+#define CXX_TEMPLATES_MEMEVENTS_HPP
+#include "../../ch09/9_1/typename.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string_view>
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define CXX_TEMPLATES_HAS_BACKTRACE 1
+#endif
+
+// 拷贝/移动事件计数：代替在每次构造时写 std::cout。
+// 编译时开关 CXX_TEMPLATES_MEM_EVENTS：
+//   0 - 关闭，memEvent() 的函数体为空，完全被编译掉
+//   1 - 每个类型一组原子计数器，程序退出时输出汇总（默认）
+//   2 - 计数，并像原来一样把每个事件打印到 std::cout
+// CXX_TEMPLATES_MEM_EVENTS_SAMPLE=N（N > 0）时，每个类型每 N 个事件（三种事件合计）记录一次调用栈。
+#ifndef CXX_TEMPLATES_MEM_EVENTS
+#define CXX_TEMPLATES_MEM_EVENTS 1
+#endif
+#ifndef CXX_TEMPLATES_MEM_EVENTS_SAMPLE
+#define CXX_TEMPLATES_MEM_EVENTS_SAMPLE 0
+#endif
+
+enum class MemEvent { TemplateConstruct, Copy, Move };
+
+inline constexpr int memEventsLevel = CXX_TEMPLATES_MEM_EVENTS;
+inline constexpr unsigned memEventsSample = CXX_TEMPLATES_MEM_EVENTS_SAMPLE;
+
+inline char const* memEventName(MemEvent e)
+{
+    switch (e) {
+        case MemEvent::TemplateConstruct: return "TMPL-CONSTR";
+        case MemEvent::Copy:              return "COPY-CONSTR";
+        case MemEvent::Move:              return "MOVE-CONSTR";
+    }
+    return "?";
+}
+
+// 一个类型的全部计数器；只含原子量，可以常量初始化，也不需要析构
+struct MemEventCounters
+{
+    static constexpr int MaxSamples = 8;
+    static constexpr int MaxFrames = 8;
+
+    std::string_view typeName;
+    std::atomic<std::uint64_t> counts[3] = {};
+    std::atomic<bool> registered{false};
+    std::atomic<std::uint64_t> events{0};           // 三种事件合计，只在采样时使用
+    std::atomic<unsigned> sampleCount{0};
+    void* samples[MaxSamples][MaxFrames] = {};
+    int sampleDepth[MaxSamples] = {};
+    MemEventCounters* next = nullptr;
+};
+
+class MemEventRegistry
+{
+private:
+    std::atomic<MemEventCounters*> head{nullptr};
+    MemEventRegistry() = default;
+public:
+    static MemEventRegistry& instance()
+    {
+        static MemEventRegistry registry;       // 在第一次注册时构造，退出时输出汇总
+        return registry;
+    }
+
+    void add(MemEventCounters& c)
+    {
+        c.next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(c.next, &c, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+        }
+    }
+
+    void report(std::ostream& os) const
+    {
+        os << "copy/move events:\n";
+        for (auto* c = head.load(std::memory_order_acquire); c; c = c->next) {
+            os << "  " << c->typeName << ": "
+               << memEventName(MemEvent::TemplateConstruct) << ' ' << c->counts[0] << ", "
+               << memEventName(MemEvent::Copy) << ' ' << c->counts[1] << ", "
+               << memEventName(MemEvent::Move) << ' ' << c->counts[2] << '\n';
+#ifdef CXX_TEMPLATES_HAS_BACKTRACE
+            unsigned n = c->sampleCount.load(std::memory_order_relaxed);
+            for (unsigned s = 0; s < n && s < MemEventCounters::MaxSamples; ++s) {
+                os << "    sampled call stack " << s << ":\n" << std::flush;
+                backtrace_symbols_fd(c->samples[s], c->sampleDepth[s], fileno(stderr));
+            }
+#endif
+        }
+    }
+
+    ~MemEventRegistry()
+    {
+        report(std::cerr);
+    }
+};
+
+template<typename T>
+struct MemEventsOf
+{
+    static inline MemEventCounters counters{typeName<T>()};     // 汇总中显示的类型名，静态存储
+};
+
+// 记录一次调用栈，最多 MaxSamples 次
+inline void sampleMemEvent(MemEventCounters& c)
+{
+#ifdef CXX_TEMPLATES_HAS_BACKTRACE
+    unsigned s = c.sampleCount.fetch_add(1, std::memory_order_relaxed);
+    if (s < MemEventCounters::MaxSamples) {
+        c.sampleDepth[s] = backtrace(c.samples[s], MemEventCounters::MaxFrames);
+    }
+#endif
+}
+
+// 在构造函数中调用：memEvent<Person>(MemEvent::Copy, name)
+template<typename T, typename Detail>
+inline void memEvent(MemEvent e, [[maybe_unused]] Detail const& detail)
+{
+    if constexpr (memEventsLevel > 0) {
+        MemEventCounters& c = MemEventsOf<T>::counters;
+        if (!c.registered.load(std::memory_order_relaxed)
+            && !c.registered.exchange(true, std::memory_order_acq_rel)) {
+            MemEventRegistry::instance().add(c);
+        }
+        c.counts[static_cast<int>(e)].fetch_add(1, std::memory_order_relaxed);
+        if constexpr (memEventsSample > 0) {
+            constexpr unsigned every = memEventsSample > 0 ? memEventsSample : 1;
+            if ((c.events.fetch_add(1, std::memory_order_relaxed) + 1) % every == 0) {
+                sampleMemEvent(c);
+            }
+        }
+        if constexpr (memEventsLevel > 1) {
+            std::cout << memEventName(e) << ' ' << c.typeName << " '" << detail << "'\n";
+        }
+    }
+}
+#endif //CXX_TEMPLATES_MEMEVENTS_HPP
@@ -2,6 +2,7 @@
 #include <string>
 #include <iostream>
 #include <type_traits>
+#include "memevents.hpp"
 
 template <typename T>
 using EnableIfString = std::enable_if_t<std::is_convertible_v<T, std::string>>;
@@ -16,16 +17,16 @@ public:
     template <typename STR, typename = EnableIfString<STR>>
     explicit Person(STR &&n) : name(std::forward<STR>(n))
     {
-        std::cout << "TMPL-CONSTR for '" << name << "'\n";
+        memEvent<Person>(MemEvent::TemplateConstruct, name);
     }
     // 拷贝构造 (2)
     Person(Person const &p) : name(p.name)
     {
-        std::cout << "COPY-CONSTR Person '" << name << "'\n";
+        memEvent<Person>(MemEvent::Copy, name);
     }
     // 移动构造 (3)
     Person(Person &&p) : name(std::move(p.name))
     {
-        std::cout << "MOVE-CONSTR Person '" << name << "'\n";
+        memEvent<Person>(MemEvent::Move, name);
     }
 };
\ No newline at end of file
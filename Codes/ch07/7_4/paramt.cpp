@@ -0,0 +1,88 @@
+#include "paramt.hpp"
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct Pod256
+{
+    char data[256];
+    friend bool operator<(Pod256 const& a, Pod256 const& b)
+    {
+        return std::memcmp(a.data, b.data, sizeof(a.data)) < 0;
+    }
+};
+
+static_assert(std::is_same_v<param_t<int>, int>);
+static_assert(std::is_same_v<param_t<double*>, double*>);
+static_assert(std::is_same_v<param_t<std::string>, std::string const&>);
+static_assert(std::is_same_v<param_t<Pod256>, Pod256 const&>);
+static_assert(std::is_same_v<param_t<std::reference_wrapper<std::string const>>,
+                             std::reference_wrapper<std::string const>>);
+
+// noipa 阻止内联和跨过程优化（如 GCC 把 const& 参数改成按值的 .isra 克隆），
+// 比较的是真实的调用约定：用 g++ -O2 -S 查看三种版本的汇编；代码体积见 paramtsize.sh
+template<typename T>
+[[gnu::noipa]] bool lessByValue(T a, T b) { return a < b; }
+
+template<typename T>
+[[gnu::noipa]] bool lessByRef(T const& a, T const& b) { return a < b; }
+
+template<typename T>
+[[gnu::noipa]] bool lessByParam(param_t<T> a, param_t<T> b) { return a < b; }
+
+// 比较结果写入 volatile 变量，保证每次比较都必须执行
+std::size_t volatile sink = 0;
+
+template<typename T, typename F>
+double bench(std::vector<T> const& v, F less)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::size_t count = 0;
+    for (int rep = 0; rep < 20; ++rep) {
+        for (std::size_t i = 1; i < v.size(); ++i) {
+            count += less(v[i - 1], v[i]);
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count();
+    sink = count;
+    return ns / (20.0 * (v.size() - 1));
+}
+
+template<typename T>
+void compare(char const* title, std::vector<T> const& v)
+{
+    std::cout << title
+              << ": by value " << bench(v, [](T const& a, T const& b) { return lessByValue<T>(a, b); })
+              << " ns, by const& " << bench(v, [](T const& a, T const& b) { return lessByRef<T>(a, b); })
+              << " ns, param_t " << bench(v, [](T const& a, T const& b) { return lessByParam<T>(a, b); })
+              << " ns\n";
+}
+
+int main()
+{
+    std::string s1 = "mathematics";
+    std::string s2 = "math";
+    std::cout << "max(7, 42): " << ::max(7, 42) << '\n';
+    std::cout << "max(s1, s2): " << ::max(s1, s2) << '\n';
+    print(7.5, "hello", s1);
+    printT(s1);                 // 不拷贝 s1
+    printT(std::cref(s1));      // 仍然可用
+
+    constexpr std::size_t N = 100'000;
+    std::vector<int> ints(N);
+    std::vector<std::string> strs(N);
+    std::vector<Pod256> pods(N / 10);
+    for (std::size_t i = 0; i < N; ++i) {
+        ints[i] = static_cast<int>(i * 2654435761u);
+        strs[i] = "a fairly long string that does not fit SSO " + std::to_string(i);
+    }
+    for (std::size_t i = 0; i < pods.size(); ++i) {
+        std::memset(pods[i].data, 'x', sizeof(pods[i].data));
+        pods[i].data[255] = static_cast<char>(i);
+    }
+    compare("int        ", ints);
+    compare("std::string", strs);
+    compare("Pod256     ", pods);
+}
@@ -0,0 +1,66 @@
+#ifndef CXX_TEMPLATES_PARAMT_HPP
+#define CXX_TEMPLATES_PARAMT_HPP
+#include <functional>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+// 参数传递策略：不超过两个寄存器大小的可平凡拷贝类型按值传递，其余按 const& 传递。
+// 参数类型里的 param_t<T> 是不可推导语境，因此每个模板都分两层：
+// 外层按 T const& 推导（内联后没有开销），内层显式指定 T，用 param_t<T> 接收参数。
+template<typename T>
+using param_t = std::conditional_t<std::is_trivially_copyable_v<T>
+                                       && sizeof(T) <= 2 * sizeof(void*),
+                                   T, T const&>;
+
+// ch01 中的 max()：按值传递 int，按引用传递 std::string
+template<typename T>
+T maxImpl(param_t<T> a, param_t<T> b)
+{
+    return b < a ? a : b;
+}
+
+template<typename T>
+std::decay_t<T const> max(T const& a, T const& b)
+{
+    return maxImpl<std::decay_t<T const>>(a, b);
+}
+
+// ch04/4_1 中的 print()
+inline void print()
+{
+}
+
+template<typename T, typename... Types>
+void printImpl(param_t<T> firstArg, param_t<Types>... args)
+{
+    std::cout << firstArg << '\n';  // 打印第一个参数
+    if constexpr (sizeof...(Types) > 0) {
+        printImpl<Types...>(args...);   // 对剩余的参数递归调用
+    }
+}
+
+template<typename T, typename... Types>
+void print(T const& firstArg, Types const&... args)
+{
+    printImpl<std::decay_t<T const>, std::decay_t<Types const>...>(firstArg, args...);
+}
+
+// cref.cpp 中的 printT()：std::string 自动按引用传递，不再需要 std::cref()
+inline void printString(std::string const& s)
+{
+    std::cout << s << '\n';
+}
+
+template<typename T>
+void printTImpl(param_t<T> arg)
+{
+    printString(arg);
+}
+
+template<typename T>
+void printT(T const& arg)
+{
+    printTImpl<T>(arg);
+}
+#endif //CXX_TEMPLATES_PARAMT_HPP
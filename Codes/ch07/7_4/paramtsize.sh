@@ -0,0 +1,59 @@
+#!/bin/sh
+# 代码体积基准：N 个调用点调用比较函数，对比两种参数传递方式生成的代码
+#   value  ：template<typename T> bool less(T a, T b)，每个调用点先把两个实参各拷贝一份；
+#   param_t：template<typename T> bool less(param_t<T> a, param_t<T> b)（paramt.hpp），
+#            int 仍按值放进寄存器，std::string 和 256 字节的 POD 只传地址。
+# 被调函数用 noipa 阻止内联和 .isra 克隆，与 paramt.cpp 相同。
+# 报告 -O2 下目标文件的 .text 字节数，以及调用方 use() 和被调函数各自的字节数。
+# 用法：sh paramtsize.sh [N] [g++]
+N=${1:-32}
+CXX=${2:-g++}
+DIR=$(cd "$(dirname "$0")" && pwd)
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+seq0() { i=0; while [ $i -lt "$1" ]; do echo $i; i=$((i + 1)); done; }
+
+# $1：类型，$2：被调函数的参数列表
+program() {
+    cat <<EOT
+#include "$DIR/paramt.hpp"
+#include <cstring>
+#include <string>
+struct Pod256
+{
+    char data[256];
+    friend bool operator<(Pod256 const& a, Pod256 const& b)
+    {
+        return std::memcmp(a.data, b.data, sizeof(a.data)) < 0;
+    }
+};
+template<typename T>
+[[gnu::noipa]] bool less($2) { return a < b; }
+int use($1 const* v)
+{
+    int r = 0;
+EOT
+    for i in $(seq0 "$N"); do
+        echo "    r += less<$1>(v[$i], v[$((i + 1))]);"
+    done
+    echo "    return r;"
+    echo "}"
+}
+
+# 目标文件中名字含 $2 的函数的字节数之和
+symbytes() {
+    nm -S -t d --defined-only "$1" | awk -v s="$2" '$3 ~ /^[tTwW]$/ && $4 ~ s { n += $2 } END { print n + 0 }'
+}
+
+echo "| type | variant | .text bytes | use() bytes | less() bytes |"
+echo "|---|---|---|---|---|"
+for t in int std::string Pod256; do
+    for v in value param_t; do
+        if [ $v = value ]; then params="T a, T b"; else params="param_t<T> a, param_t<T> b"; fi
+        program "$t" "$params" > "$TMP/p.cpp"
+        $CXX -std=c++17 -O2 -DNDEBUG -c "$TMP/p.cpp" -o "$TMP/p.o" || exit 1
+        text=$(size "$TMP/p.o" | awk 'NR == 2 { print $1 }')
+        echo "| $t | $v | $text | $(symbytes "$TMP/p.o" _Z3use) | $(symbytes "$TMP/p.o" _Z4less) |"
+    done
+done
@@ -7,7 +7,7 @@ struct DoIsPrime
 template<unsigned p>
 struct DoIsPrime<p, 2>
 {
-    static constexpr bool value = (p % 2 == 0);
+    static constexpr bool value = (p % 2 != 0);
 };
 
 template<unsigned p>
@@ -0,0 +1,60 @@
+#!/bin/sh
+# 比较 isprime.hpp 中递归的 IsPrime<p> 与 primes.hpp 中 constexpr 的 IsPrimeFast<p> 的编译期开销。
+# IsPrime<p> 为每个 p 实例化 p/2 - 1 个 DoIsPrime<p, d>，递归深度同样是 p/2；
+# IsPrimeFast<p> 只实例化 1 个类，constexpr 求值最多循环 sqrt(p)/6 次。
+# 实例化个数是实测的：另外编译一次，带 -g -fno-eliminate-unused-debug-types，
+# 统计调试信息中 DoIsPrime<...> / IsPrimeFast<...> 类型的个数（不计入耗时）。
+# 用法：sh primebench.sh ["1000 2000 4000 8000 16000"] [g++]
+SIZES=${1:-"1000 2000 4000 8000 16000"}
+CXX=${2:-g++}
+DIR=$(cd "$(dirname "$0")" && pwd)
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+# 生成对 [p - 200, p) 内所有奇数求值的翻译单元
+gen() {
+    engine=$1; p=$2
+    {
+        if [ "$engine" = IsPrime ]; then
+            echo "#include \"$DIR/../8_1/isprime.hpp\""
+        else
+            echo "#include \"$DIR/primes.hpp\""
+        fi
+        i=$((p - 199))
+        while [ $i -lt $p ]; do
+            echo "static_assert($engine<$i>::value || true);"
+            i=$((i + 2))
+        done
+    } > "$TMP/$engine.cpp"
+}
+
+now() { date +%s%N; }
+
+# 翻译单元中实际实例化的类模板个数
+count() {
+    file=$1; pattern=$2; shift 2
+    if "$CXX" -std=c++17 -g -fno-eliminate-unused-debug-types "$@" -c "$file" -o "$TMP/count.o" 2>/dev/null; then
+        readelf --debug-dump=info "$TMP/count.o" | grep -c "DW_AT_name.*$pattern<"
+    else
+        echo failed
+    fi
+}
+
+printf '%10s %16s %16s %24s\n' p IsPrime-ms IsPrimeFast-ms instantiations
+for p in $SIZES; do
+    gen IsPrime $p
+    gen IsPrimeFast $p
+    t0=$(now)
+    if "$CXX" -std=c++17 -fsyntax-only -ftemplate-depth=$((p / 2 + 100)) "$TMP/IsPrime.cpp" 2>/dev/null; then
+        old=$(( ($(now) - t0) / 1000000 ))
+    else
+        old=failed
+    fi
+    t0=$(now)
+    "$CXX" -std=c++17 -fsyntax-only "$TMP/IsPrimeFast.cpp"
+    new=$(( ($(now) - t0) / 1000000 ))
+    # 100 个 p，每个约 p/2 个 DoIsPrime<> 对比 100 个 IsPrimeFast<>
+    slow=$(count "$TMP/IsPrime.cpp" DoIsPrime -ftemplate-depth=$((p / 2 + 100)))
+    fast=$(count "$TMP/IsPrimeFast.cpp" IsPrimeFast)
+    printf '%10s %16s %16s %24s\n' $p "$old" "$new" "$slow vs $fast"
+done
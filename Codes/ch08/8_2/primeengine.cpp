@@ -0,0 +1,60 @@
+#include "primeengine.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    std::cout << std::boolalpha
+              << "2^61-1: " << isPrime64((u64(1) << 61) - 1) << '\n'          // true
+              << "2^64-59: " << isPrime64(18446744073709551557ull) << '\n'    // true，最大的 64 位质数
+              << "3215031751: " << isPrime64(3215031751ull) << '\n';         // false，强伪质数
+
+    // Miller–Rabin 与分段筛互相校验
+    u64 mismatches = 0;
+    u64 lo = 1'000'000'000'000ull;
+    std::vector<u64> sieved;
+    forEachPrimeInRange(lo, lo + 1'000'000, [&](u64 p) { sieved.push_back(p); });
+    std::size_t k = 0;
+    for (u64 n = lo; n < lo + 1'000'000; ++n) {
+        bool inSieve = k < sieved.size() && sieved[k] == n;
+        k += inSieve;
+        mismatches += inSieve != isPrime64(n);
+    }
+    std::cout << "primes in [10^12, 10^12 + 10^6): " << sieved.size()
+              << ", mismatches " << mismatches << '\n';
+
+    unsigned threads = defaultThreads();
+    std::size_t batch = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+    u64 rangeEnd = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1'000'000'000ull;
+
+    std::mt19937_64 rng(2024);
+    std::vector<u64> values(batch);
+    for (auto& v : values) {
+        v = rng() | 1;
+    }
+    std::unique_ptr<bool[]> results(new bool[batch]);
+    double batchMs = measure([&] { isPrimeBatch(values.data(), results.get(), batch, threads); });
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < batch; ++i) {
+        found += results[i];
+    }
+    std::cout << batch << " random odd u64 on " << threads << " thread(s): " << batchMs
+              << " ms (" << batchMs * 1e6 / batch << " ns/value), " << found << " primes\n";
+
+    u64 count = 0;
+    double rangeMs = measure([&] { count = countPrimes(0, rangeEnd, threads); });
+    std::cout << "pi(" << rangeEnd << ") = " << count << " in " << rangeMs << " ms\n";
+}
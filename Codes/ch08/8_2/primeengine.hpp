@@ -0,0 +1,246 @@
+#ifndef CXX_TEMPLATES_PRIMEENGINE_HPP
+#define CXX_TEMPLATES_PRIMEENGINE_HPP
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// 运行期质数判定：primes.hpp 中 isPrime() 的运行期对应物。
+// 单个数用确定性的 64 位 Miller–Rabin（Montgomery 乘法），区间用分段筛。
+
+using u64 = std::uint64_t;
+__extension__ typedef unsigned __int128 u128;      // __extension__：-pedantic 下不警告
+
+// 奇数模 n 下的 Montgomery 运算：x 的 Montgomery 形式为 x * 2^64 mod n
+class Montgomery
+{
+private:
+    u64 n;
+    u64 inv;        // n^-1 mod 2^64
+    u64 r2;         // 2^128 mod n
+public:
+    explicit Montgomery(u64 mod) : n(mod), inv(mod)
+    {
+        for (int i = 0; i < 5; ++i) {
+            inv *= 2 - n * inv;                     // 牛顿迭代，每次有效位数翻倍
+        }
+        u64 r = (0 - n) % n;                        // 2^64 mod n
+        r2 = static_cast<u64>(static_cast<u128>(r) * r % n);
+    }
+
+    // 计算 t * 2^-64 mod n：低 64 位与 m*n 的低 64 位恰好相消
+    u64 reduce(u128 t) const
+    {
+        u64 m = static_cast<u64>(t) * inv;
+        u64 hi = static_cast<u64>(t >> 64);
+        u64 mh = static_cast<u64>((static_cast<u128>(m) * n) >> 64);
+        return hi >= mh ? hi - mh : hi - mh + n;
+    }
+    u64 to(u64 x) const { return reduce(static_cast<u128>(x % n) * r2); }
+    u64 mul(u64 a, u64 b) const { return reduce(static_cast<u128>(a) * b); }
+    u64 one() const { return to(1); }
+
+    u64 pow(u64 base, u64 e) const
+    {
+        u64 result = one();
+        for (; e != 0; e >>= 1) {
+            if (e & 1) {
+                result = mul(result, base);
+            }
+            base = mul(base, base);
+        }
+        return result;
+    }
+};
+
+// 对所有 64 位整数确定性的 Miller–Rabin
+inline bool isPrime64(u64 n)
+{
+    static constexpr u64 small[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    if (n < 2) {
+        return false;
+    }
+    for (u64 p : small) {
+        if (n % p == 0) {
+            return n == p;
+        }
+    }
+    if (n < 41 * 41) {
+        return true;
+    }
+    u64 d = n - 1;
+    int s = 0;
+    while ((d & 1) == 0) {
+        d >>= 1;
+        ++s;
+    }
+    Montgomery mont(n);
+    u64 const one = mont.one();
+    u64 const minusOne = mont.to(n - 1);
+    // Jim Sinclair 的 7 个底数覆盖全部 2^64 以内的整数
+    static constexpr u64 bases[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+    for (u64 a : bases) {
+        if (a % n == 0) {
+            continue;
+        }
+        u64 x = mont.pow(mont.to(a), d);
+        if (x == one || x == minusOne) {
+            continue;
+        }
+        bool composite = true;
+        for (int r = 1; r < s && composite; ++r) {
+            x = mont.mul(x, x);
+            composite = x != minusOne;
+        }
+        if (composite) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 把 [0, count) 平均分给 threads 个线程
+template<typename F>
+void parallelFor(std::size_t count, unsigned threads, F f)
+{
+    threads = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, count)));
+    std::vector<std::thread> workers;
+    std::size_t chunk = (count + threads - 1) / threads;
+    for (unsigned t = 1; t < threads; ++t) {
+        std::size_t begin = std::min(count, t * chunk);
+        std::size_t end = std::min(count, begin + chunk);
+        workers.emplace_back([=, &f] { f(begin, end); });
+    }
+    f(0, std::min(count, chunk));                  // 当前线程处理第一段
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+inline unsigned defaultThreads()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// 批量判定：out[i] = isPrime64(in[i])
+inline void isPrimeBatch(u64 const* in, bool* out, std::size_t count,
+                         unsigned threads = defaultThreads())
+{
+    // 每个线程至少分到 4096 个数，小批量不值得创建线程
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, count / 4096 + 1));
+    parallelFor(count, threads, [=](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            out[i] = isPrime64(in[i]);
+        }
+    });
+}
+
+// [2, limit] 内的质数，用于分段筛的基础质数；limit 可以是 2^32 - 1，循环变量用 64 位
+inline std::vector<std::uint32_t> basePrimes(std::uint32_t limit)
+{
+    std::vector<bool> composite(std::size_t(limit) + 1);
+    std::vector<std::uint32_t> primes;
+    for (u64 i = 2; i <= limit; ++i) {
+        if (!composite[i]) {
+            primes.push_back(static_cast<std::uint32_t>(i));
+            for (u64 j = u64(i) * i; j <= limit; j += i) {
+                composite[j] = true;
+            }
+        }
+    }
+    return primes;
+}
+
+inline std::uint32_t isqrt64(u64 n)
+{
+    u64 r = 0;
+    for (u64 bit = u64(1) << 31; bit != 0; bit >>= 1) {
+        u64 c = r | bit;
+        if (c * c <= n) {
+            r = c;
+        }
+    }
+    return static_cast<std::uint32_t>(r);
+}
+
+// 分段筛：对 [lo, hi) 内的每个质数调用 f(p)，primes 至少包含 isqrt64(hi - 1) 以内的全部质数。
+// 只筛奇数，每段 SegmentBytes 字节，正好放进 L1 数据缓存。
+// 段内位置都用相对 segLo 的偏移计算，hi 接近 2^64 时也不会溢出。
+template<typename F>
+void forEachPrimeInRange(u64 lo, u64 hi, std::vector<std::uint32_t> const& primes, F f)
+{
+    constexpr std::size_t SegmentBytes = 32 * 1024;
+    constexpr u64 SegmentSpan = 2 * SegmentBytes;   // 每字节对应一个奇数
+    if (hi <= lo) {
+        return;
+    }
+    if (lo <= 2 && hi > 2) {
+        f(u64(2));
+    }
+    lo = std::max<u64>(lo, 3) | 1;                  // 从第一个 >= 3 的奇数开始
+    std::vector<unsigned char> sieve(SegmentBytes);
+    for (u64 segLo = lo; segLo < hi;) {
+        u64 span = std::min(hi - segLo, SegmentSpan);
+        u64 segHi = segLo + span;
+        std::size_t len = static_cast<std::size_t>((span + 1) / 2);
+        std::fill(sieve.begin(), sieve.begin() + len, 1);
+        for (std::size_t k = 1; k < primes.size(); ++k) {  // 跳过 2
+            u64 p = primes[k];
+            if (p * p >= segHi) {
+                break;
+            }
+            // 第一个不小于 max(p * p, segLo) 的 p 的奇数倍，相对 segLo 的偏移
+            u64 start = p * p > segLo ? p * p - segLo : (p - segLo % p) % p;
+            if (((segLo + start) & 1) == 0) {
+                start += p;                          // 只划掉奇数倍
+            }
+            for (u64 j = start; j < span; j += 2 * p) {
+                sieve[j / 2] = 0;
+            }
+        }
+        for (std::size_t i = 0; i < len; ++i) {
+            if (sieve[i]) {
+                f(segLo + 2 * i);
+            }
+        }
+        if (segHi == hi) {
+            break;
+        }
+        segLo = segHi;
+    }
+}
+
+template<typename F>
+void forEachPrimeInRange(u64 lo, u64 hi, F f)
+{
+    if (hi > lo) {
+        forEachPrimeInRange(lo, hi, basePrimes(isqrt64(hi - 1)), f);
+    }
+}
+
+// 并行统计 [lo, hi) 内的质数个数
+inline u64 countPrimes(u64 lo, u64 hi, unsigned threads = defaultThreads())
+{
+    if (hi <= lo) {
+        return 0;
+    }
+    constexpr u64 Block = u64(1) << 24;             // 每个任务单元 16M 个数
+    std::size_t blocks = static_cast<std::size_t>((hi - lo + Block - 1) / Block);
+    std::vector<u64> counts(blocks);
+    std::vector<std::uint32_t> const primes = basePrimes(isqrt64(hi - 1));
+    parallelFor(blocks, threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t b = begin; b < end; ++b) {
+            u64 n = 0;
+            u64 first = lo + b * Block;
+            forEachPrimeInRange(first, first + std::min(Block, hi - first), primes, [&n](u64) { ++n; });
+            counts[b] = n;
+        }
+    });
+    u64 total = 0;
+    for (u64 c : counts) {
+        total += c;
+    }
+    return total;
+}
+#endif //CXX_TEMPLATES_PRIMEENGINE_HPP
@@ -0,0 +1,34 @@
+#include "primes.hpp"
+#include <iostream>
+
+// 编译期前端开销的对比见 primebench.sh
+static_assert(IsPrimeFast<9>::value == false);
+static_assert(IsPrimeFast<4294967291u>::value);          // 最大的 32 位质数，IsPrime<> 无法实例化
+static_assert(primeTable<100>.test(97) && !primeTable<100>.test(91));
+
+constexpr auto smallPrimes = primesBelow<50>();
+static_assert(smallPrimes.size() == 15 && smallPrimes.back() == 47);
+
+// 与 ch08 中的 Helper<> 一样，用作非类型模板参数的条件
+template<int SZ, bool = isPrime(SZ)>
+struct Helper
+{
+    static constexpr char const* name = "not prime";
+};
+
+template<int SZ>
+struct Helper<SZ, true>
+{
+    static constexpr char const* name = "prime";
+};
+
+int main()
+{
+    for (auto p : smallPrimes) {
+        std::cout << p << ' ';
+    }
+    std::cout << '\n'
+              << "Helper<97>: " << Helper<97>::name << '\n'
+              << "Helper<91>: " << Helper<91>::name << '\n'
+              << "primes below 100000: " << primeTable<100000>.count() << '\n';
+}
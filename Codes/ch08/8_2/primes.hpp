@@ -0,0 +1,82 @@
+#ifndef CXX_TEMPLATES_PRIMES_HPP
+#define CXX_TEMPLATES_PRIMES_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// isprime.hpp 中 IsPrime<p> 的 constexpr 版本：
+// 试除只到 sqrt(p)，并且只试 2、3 和 6k±1，整个计算只有一次函数调用，不产生任何类实例化。
+constexpr bool isPrime(std::uint64_t p)
+{
+    if (p < 4) {
+        return p >= 2;
+    }
+    if (p % 2 == 0 || p % 3 == 0) {
+        return false;
+    }
+    for (std::uint64_t d = 5; d <= p / d; d += 6) {
+        if (p % d == 0 || p % (d + 2) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 与 IsPrime<p> 用法相同
+template<std::uint64_t p>
+struct IsPrimeFast : std::bool_constant<isPrime(p)>
+{
+};
+
+// 编译期埃拉托斯特尼筛：[0, N) 内每个数是否为质数，每 64 个数占一个字
+template<std::size_t N>
+class PrimeTable
+{
+private:
+    std::array<std::uint64_t, (N + 63) / 64> bits{};
+public:
+    constexpr PrimeTable()
+    {
+        for (std::size_t i = 2; i < N; ++i) {
+            bits[i / 64] |= std::uint64_t(1) << (i % 64);
+        }
+        for (std::size_t i = 2; i * i < N; ++i) {
+            if (test(i)) {
+                for (std::size_t j = i * i; j < N; j += i) {
+                    bits[j / 64] &= ~(std::uint64_t(1) << (j % 64));
+                }
+            }
+        }
+    }
+    constexpr bool test(std::size_t i) const
+    {
+        return (bits[i / 64] >> (i % 64)) & 1;
+    }
+    constexpr std::size_t count() const
+    {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            n += test(i);
+        }
+        return n;
+    }
+};
+
+template<std::size_t N>
+inline constexpr PrimeTable<N> primeTable{};
+
+// [0, N) 内所有质数组成的数组，长度在编译期确定
+template<std::size_t N>
+constexpr auto primesBelow()
+{
+    std::array<std::uint32_t, primeTable<N>.count()> result{};
+    std::size_t k = 0;
+    for (std::size_t i = 2; i < N; ++i) {
+        if (primeTable<N>.test(i)) {
+            result[k++] = static_cast<std::uint32_t>(i);
+        }
+    }
+    return result;
+}
+#endif //CXX_TEMPLATES_PRIMES_HPP
@@ -0,0 +1,131 @@
+#!/bin/sh
+# 编译期性能基准：为仓库中的元编程模式生成规模为 N 的翻译单元，
+# 用 -ftime-report 记录前端时间、模板实例化时间和 GGC 内存，用 nm 统计生成的函数模板实例个数，
+# 并对比不同写法：递归 vs 折叠表达式、SFINAE vs if constexpr vs concepts。
+# 用法：sh ctbench.sh ["1 4 16 64 256 1024"] [g++]
+SIZES=${1:-"1 4 16 64 256 1024"}
+CXX=${2:-g++}
+DIR=$(cd "$(dirname "$0")" && pwd)
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+seq0() { i=0; while [ $i -lt "$1" ]; do echo $i; i=$((i + 1)); done; }
+
+# 逗号分隔的 0..N-1
+args() { seq0 "$1" | paste -sd, -; }
+
+# 每个生成函数把规模为 $1 的翻译单元写到标准输出
+gen_print_recursion() {     # ch04/4_1 varprint1.hpp：每层递归一个实例
+    echo "#include \"$DIR/../../ch04/4_1/varprint1.hpp\""
+    echo "void use() { print($(args "$1")); }"
+}
+
+gen_print_fold() {          # ch04/4_2 addspace.cpp：一个折叠表达式
+    cat <<EOF
+#include <iostream>
+template<typename... Args>
+void print(Args... args) { ((std::cout << args << '\n'), ...); }
+void use() { print($(args "$1")); }
+EOF
+}
+
+gen_overloader() {          # ch04/4_2 varusing.cpp：N 个基类的 Overloader
+    for i in $(seq0 "$1"); do
+        echo "struct Tag$i {}; struct F$i { int operator()(Tag$i) const { return $i; } };"
+    done
+    echo "template<typename... Bases> struct Overloader : Bases... { using Bases::operator()...; };"
+    echo "using All = Overloader<$(seq0 "$1" | sed 's/^/F/' | paste -sd, -)>;"
+    echo "int use() { All all; return all(Tag$(($1 - 1)){}); }"
+}
+
+gen_dispatch_sfinae() {     # ch06/6_4 specialmemtmpl.hpp（EnableIfString 约束的构造函数模板）的放大版：N 个用 enable_if 约束的构造函数模板，N 次构造
+    echo "#include <type_traits>"
+    for i in $(seq0 "$1"); do echo "struct Tag$i {};"; done
+    echo "struct Person { int id;"
+    for i in $(seq0 "$1"); do
+        echo "    template<typename T, std::enable_if_t<std::is_same_v<T, Tag$i>, int> = 0> Person(T) : id($i) {}"
+    done
+    echo "};"
+    echo "int use() { return 0 $(seq0 "$1" | sed 's/.*/+ Person(Tag&{}).id/' | paste -sd' ' -); }"
+}
+
+gen_dispatch_concepts() {   # 同上，用 requires 子句代替 enable_if
+    echo "#include <type_traits>"
+    for i in $(seq0 "$1"); do echo "struct Tag$i {};"; done
+    echo "struct Person { int id;"
+    for i in $(seq0 "$1"); do
+        echo "    template<typename T> requires std::is_same_v<T, Tag$i> Person(T) : id($i) {}"
+    done
+    echo "};"
+    echo "int use() { return 0 $(seq0 "$1" | sed 's/.*/+ Person(Tag&{}).id/' | paste -sd' ' -); }"
+}
+
+gen_dispatch_ifconstexpr() { # 同上，只有一个构造函数模板，内部用 if constexpr 链分派
+    echo "#include <type_traits>"
+    for i in $(seq0 "$1"); do echo "struct Tag$i {};"; done
+    echo "struct Person { int id = -1;"
+    echo "    template<typename T> Person(T) {"
+    for i in $(seq0 "$1"); do
+        echo "        if constexpr (std::is_same_v<T, Tag$i>) id = $i; else"
+    done
+    echo "        {} } };"
+    echo "int use() { return 0 $(seq0 "$1" | sed 's/.*/+ Person(Tag&{}).id/' | paste -sd' ' -); }"
+}
+
+gen_isprime_recursion() {   # ch08/8_1 isprime.hpp：p = 3, 5, ..., 2N+1
+    echo "#include \"$DIR/../8_1/isprime.hpp\""
+    for i in $(seq0 "$1"); do echo "static_assert(IsPrime<$((2 * i + 3))>::value || true);"; done
+}
+
+gen_isprime_constexpr() {   # ch08/8_2 primes.hpp
+    echo "#include \"$DIR/../8_2/primes.hpp\""
+    for i in $(seq0 "$1"); do echo "static_assert(IsPrimeFast<$((2 * i + 3))>::value || true);"; done
+}
+
+gen_len_sfinae() {          # ch08/8_4 len2.hpp：N 个不同大小的数组
+    echo "#include \"$DIR/../8_4/len2.hpp\""
+    echo "#include <vector>"
+    for i in $(seq0 "$1"); do echo "int a$i[$((i + 1))];"; done
+    echo "std::size_t use() { std::vector<int> v; return len(v) $(seq0 "$1" | sed 's/.*/+ len(a&)/' | paste -sd' ' -); }"
+}
+
+gen_len_ifconstexpr() {     # 同上，用一个 if constexpr 函数模板代替重载集合
+    cat <<EOF
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+template<typename T>
+std::size_t len(T const& t) {
+    if constexpr (std::is_array_v<T>) return std::extent_v<T>;
+    else if constexpr (std::is_class_v<T>) return t.size();
+    else return 0;
+}
+EOF
+    for i in $(seq0 "$1"); do echo "int a$i[$((i + 1))];"; done
+    echo "std::size_t use() { std::vector<int> v; return len(v) $(seq0 "$1" | sed 's/.*/+ len(a&)/' | paste -sd' ' -); }"
+}
+
+# 编译一个翻译单元，输出：总时间(s) 实例化时间(s) GGC 内存 函数模板实例个数。
+# GCC 没有统计类模板实例个数的开关，IsPrime 等纯类模板的开销体现在实例化时间和内存上。
+measure() {
+    "$CXX" -std=c++20 -O0 -c -ftemplate-depth=4096 -ftime-report \
+        "$TMP/tu.cpp" -o "$TMP/tu.o" 2> "$TMP/report" || { echo "failed - - -"; return; }
+    awk -F: '
+        /template instantiation/ { gsub(/\([^)]*\)/, "", $2); split($2, f, " "); inst = f[3] }
+        /TOTAL/                  { split($2, f, " "); total = f[3]; mem = f[4] }
+        END { printf "%s %s %s ", total, inst == "" ? "0.00" : inst, mem }' "$TMP/report"
+    # 名字中带模板实参列表的已生成函数
+    nm -C "$TMP/tu.o" | grep -c ' [TW] .*<'
+}
+
+echo "| pattern | N | total s | instantiation s | GGC memory | function instances |"
+echo "|---|---|---|---|---|---|"
+for pattern in print_recursion print_fold overloader \
+               dispatch_sfinae dispatch_concepts dispatch_ifconstexpr \
+               isprime_recursion isprime_constexpr len_sfinae len_ifconstexpr; do
+    for n in $SIZES; do
+        "gen_$pattern" "$n" > "$TMP/tu.cpp"
+        set -- $(measure)
+        echo "| $pattern | $n | $1 | $2 | $3 | $4 |"
+    done
+done
@@ -0,0 +1,12 @@
+#ifndef MYFIRST3_HPP
+#define MYFIRST3_HPP
+#include <iostream>
+#include "typename.hpp"
+
+// 包含模型的 printTypeof()：用编译期类型名代替 typeid(x).name()，
+// 不需要 RTTI，输出的也不是修饰名
+template<typename T>
+void printTypeof(T const&) {
+    std::cout << typeName<T>() << '\n';
+}
+#endif // MYFIRST3_HPP
@@ -0,0 +1,64 @@
+#include "myfirst3.hpp"
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#if defined(__GXX_RTTI) || defined(_CPPRTTI)
+#include <cstdlib>
+#include <cxxabi.h>
+#include <typeinfo>
+#endif
+
+static_assert(typeName<int>() == "int");
+static_assert(typeName<std::vector<double>>().size() > 0);
+static_assert(typeHash<int>() != typeHash<unsigned>());
+// 数组类型的名字中含有 ']'，不能在第一个 ']' 处截断
+static_assert(typeName<int[3]>().back() == ']');
+static_assert(typeName<int (*)[4]>().back() == ']');
+static_assert(typeName<char const (&)[6]>().back() == ']');
+#if defined(__GNUC__) && !defined(__clang__)
+static_assert(typeName<int[3]>() == "int [3]");
+static_assert(typeName<int (*)[4]>() == "int (*)[4]");
+static_assert(typeName<char[6]>() == "char [6]");     // printTypeof("hello") 推导出的 T
+#endif
+
+template<typename F>
+double nsPerCall(F f)
+{
+    constexpr int N = 1'000'000;
+    std::size_t volatile sink = 0;                      // 保证每次调用的结果都被使用
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < N; ++i) {
+        sink = sink + f();
+    }
+    double ns = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count();
+    return ns / N;
+}
+
+int main()
+{
+    double ice = 3.0;
+    printTypeof(ice);                                   // double
+    printTypeof("hello");                               // char [6]
+    int arr[3] = {};
+    printTypeof(arr);                                   // int [3]
+    printTypeof(std::map<std::string, int>{});
+    std::cout << "typeHash<double>(): " << std::hex << typeHash<double>() << std::dec << '\n';
+
+    using Type = std::map<std::string, std::vector<int>>;
+    std::cout << "typeName<>():                  "
+              << nsPerCall([] { return typeName<Type>().size(); }) << " ns\n";
+#if defined(__GXX_RTTI) || defined(_CPPRTTI)
+    // 对照组：typeid().name() 加上运行期反修饰
+    std::cout << "typeid().name() + demangle:    "
+              << nsPerCall([] {
+                     int status = 0;
+                     char* s = abi::__cxa_demangle(typeid(Type).name(), nullptr, nullptr, &status);
+                     std::size_t len = std::string_view(s).size();
+                     std::free(s);
+                     return len;
+                 })
+              << " ns\n";
+#endif
+}
@@ -0,0 +1,63 @@
+#ifndef CXX_TEMPLATES_TYPENAME_HPP
+#define CXX_TEMPLATES_TYPENAME_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// 不依赖 RTTI 的编译期类型名：从 __PRETTY_FUNCTION__（MSVC 为 __FUNCSIG__）中截取，
+// 截取结果保存在只含类型名本身的静态数组里，运行期没有任何开销，可以用 -fno-rtti 编译。
+// 注意：与 typeid(x).name() 不同，这里得到的是静态类型，不是多态对象的动态类型。
+
+template<typename T>
+constexpr std::string_view rawTypeName()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    std::string_view f = __FUNCSIG__;
+    auto begin = f.find("rawTypeName<") + 12;
+    auto end = f.rfind(">(void)");
+#else
+    // GCC: "... rawTypeName() [with T = int; std::string_view = ...]"
+    // Clang: "... rawTypeName() [T = int]"
+    // 数组类型的名字本身含有 ']'（"char [6]"），所以从末尾往前找结束位置
+    std::string_view f = __PRETTY_FUNCTION__;
+    auto begin = f.find("T = ") + 4;
+#if defined(__clang__)
+    auto end = f.rfind(']');
+#else
+    auto end = f.rfind("; std::string_view");
+#endif
+#endif
+    return f.substr(begin, end - begin);
+}
+
+template<typename T>
+struct TypeNameHolder
+{
+    static constexpr std::string_view raw = rawTypeName<T>();
+    static constexpr auto chars = [] {
+        std::array<char, raw.size() + 1> a{};       // 以 '\0' 结尾，也可当作 C 字符串使用
+        for (std::size_t i = 0; i < raw.size(); ++i) {
+            a[i] = raw[i];
+        }
+        return a;
+    }();
+};
+
+template<typename T>
+constexpr std::string_view typeName()
+{
+    return std::string_view(TypeNameHolder<T>::chars.data(), TypeNameHolder<T>::raw.size());
+}
+
+// 类型名的 64 位 FNV-1a 哈希：同一编译器下跨编译单元、跨进程稳定
+template<typename T>
+constexpr std::uint64_t typeHash()
+{
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    for (char c : typeName<T>()) {
+        h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+    return h;
+}
+#endif //CXX_TEMPLATES_TYPENAME_HPP
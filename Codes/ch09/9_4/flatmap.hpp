@@ -0,0 +1,244 @@
+#ifndef CXX_TEMPLATES_FLATMAP_HPP
+#define CXX_TEMPLATES_FLATMAP_HPP
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// 先批量构建、之后只读查找的有序映射，用来代替 errornovel1.cpp 中那样的 std::map<std::string, double>。
+//   - 键和值分别存放在两个按键排序的数组中，可以按顺序遍历，也可以对键数组直接用 std::find_if；
+//   - 查找不在排序数组上二分，而是在一棵静态 B 树上进行：每个节点是一条缓存行（8 个 64 位搜索键），
+//     节点按隐式下标存放，没有指针；节点内用 AVX2 一次比较 4 个键（没有 AVX2 时是可以自动向量化的循环）；
+//   - 搜索键是键的 64 位保序映射：整数是它本身，字符串是跳过全体公共前缀后的 8 个字节（大端）。
+//     前缀相同的字符串在排序数组中相邻，命中后再比较完整字符串；
+//   - 字符串键可以直接用 std::string_view 或 char const* 查找，不构造 std::string。
+// build() 之前只能 insert()，build() 之后只能查找。
+
+namespace flatmapdetail {
+
+template<typename Key, typename = void>
+struct SearchKey;
+
+// 整数：有符号数翻转符号位，使无符号比较与原来的顺序一致
+template<typename Key>
+struct SearchKey<Key, std::enable_if_t<std::is_integral_v<Key>>>
+{
+    using Lookup = Key;
+    static std::uint64_t of(Key k, std::size_t)
+    {
+        if constexpr (std::is_signed_v<Key>) {
+            return static_cast<std::uint64_t>(static_cast<std::int64_t>(k)) ^ (std::uint64_t(1) << 63);
+        }
+        else {
+            return static_cast<std::uint64_t>(k);
+        }
+    }
+};
+
+// 字符串：跳过所有键共有的前缀后的 8 个字节，按大端拼成整数，不足补 0
+template<>
+struct SearchKey<std::string>
+{
+    using Lookup = std::string_view;
+    static std::uint64_t of(std::string_view s, std::size_t skip)
+    {
+        unsigned char b[8] = {};
+        if (s.size() > skip) {
+            std::memcpy(b, s.data() + skip, std::min<std::size_t>(s.size() - skip, 8));
+        }
+        std::uint64_t v = 0;
+        for (unsigned char c : b) {
+            v = (v << 8) | c;
+        }
+        return v;
+    }
+};
+
+} // namespace flatmapdetail
+
+template<typename Key, typename Value>
+class FlatMap
+{
+private:
+    using Search = flatmapdetail::SearchKey<Key>;
+    using Lookup = typename Search::Lookup;
+
+    static constexpr std::size_t B = 8;                 // 每个节点 8 个键，64 字节
+    static constexpr std::uint64_t Pad = ~std::uint64_t(0);
+
+    struct alignas(64) Node
+    {
+        std::int64_t keys[B];       // 搜索键异或符号位后按有符号数保存，便于 AVX2 有符号比较
+    };
+
+    std::vector<std::pair<Key, Value>> staged;
+    std::vector<Key> sortedKeys;
+    std::vector<Value> sortedValues;
+    std::vector<std::uint64_t> prefixes;                // 与 sortedKeys 对应的搜索键
+    std::unique_ptr<Node[]> tree;
+    std::vector<std::uint32_t> ranks;                   // 树中每个位置对应的排序下标
+    std::size_t blocks = 0;
+    std::size_t skip = 0;                               // 所有键的公共前缀长度（仅字符串键）
+
+    static std::int64_t toSigned(std::uint64_t k)
+    {
+        return static_cast<std::int64_t>(k ^ (std::uint64_t(1) << 63));
+    }
+
+    static std::size_t child(std::size_t k, std::size_t i) { return k * (B + 1) + i + 1; }
+
+    // 中序遍历隐式 B 树，依次填入排序后的搜索键
+    void fill(std::size_t k, std::size_t& t)
+    {
+        if (k >= blocks) {
+            return;
+        }
+        for (std::size_t i = 0; i < B; ++i) {
+            fill(child(k, i), t);
+            bool real = t < prefixes.size();
+            tree[k].keys[i] = toSigned(real ? prefixes[t] : Pad);
+            ranks[k * B + i] = static_cast<std::uint32_t>(real ? t++ : prefixes.size());
+        }
+        fill(child(k, B), t);
+    }
+
+    // 节点内第一个 >= x 的位置，即小于 x 的键的个数
+    static std::size_t rankInNode(Node const& node, std::int64_t x)
+    {
+#ifdef __AVX2__
+        __m256i vx = _mm256_set1_epi64x(x);
+        __m256i lo = _mm256_load_si256(reinterpret_cast<__m256i const*>(node.keys));
+        __m256i hi = _mm256_load_si256(reinterpret_cast<__m256i const*>(node.keys + 4));
+        unsigned mlo = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(vx, lo))));
+        unsigned mhi = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(vx, hi))));
+        return static_cast<std::size_t>(__builtin_popcount(mlo | (mhi << 4)));
+#else
+        std::size_t r = 0;
+        for (std::size_t i = 0; i < B; ++i) {
+            r += node.keys[i] < x;
+        }
+        return r;
+#endif
+    }
+
+    // 第一个搜索键 >= p 的排序下标
+    std::size_t lowerBound(std::uint64_t p) const
+    {
+        std::int64_t x = toSigned(p);
+        std::size_t result = prefixes.size();
+        for (std::size_t k = 0; k < blocks;) {
+            std::size_t i = rankInNode(tree[k], x);
+            if (i < B) {
+                result = ranks[k * B + i];
+            }
+            k = child(k, i);
+        }
+        return result;
+    }
+
+public:
+    FlatMap() = default;
+
+    template<typename It>
+    FlatMap(It first, It last)
+    {
+        for (; first != last; ++first) {
+            insert(first->first, first->second);
+        }
+        build();
+    }
+
+    void insert(Key k, Value v)
+    {
+        staged.emplace_back(std::move(k), std::move(v));
+    }
+
+    // 排序（重复的键保留第一次插入的值）并建立查找结构
+    void build()
+    {
+        std::stable_sort(staged.begin(), staged.end(),
+                         [](auto const& a, auto const& b) { return a.first < b.first; });
+        staged.erase(std::unique(staged.begin(), staged.end(),
+                                 [](auto const& a, auto const& b) { return a.first == b.first; }),
+                     staged.end());
+        sortedKeys.clear();
+        sortedValues.clear();
+        prefixes.clear();
+        skip = 0;
+        if constexpr (!std::is_integral_v<Key>) {
+            // 有序序列的公共前缀就是首尾两个键的公共前缀
+            if (!staged.empty()) {
+                Key const& a = staged.front().first;
+                Key const& b = staged.back().first;
+                while (skip < a.size() && skip < b.size() && a[skip] == b[skip]) {
+                    ++skip;
+                }
+            }
+        }
+        for (auto& kv : staged) {
+            prefixes.push_back(Search::of(kv.first, skip));
+            sortedKeys.push_back(std::move(kv.first));
+            sortedValues.push_back(std::move(kv.second));
+        }
+        staged.clear();
+        staged.shrink_to_fit();
+        blocks = (prefixes.size() + B - 1) / B;
+        tree.reset(new Node[blocks]);
+        ranks.assign(blocks * B, 0);
+        std::size_t t = 0;
+        fill(0, t);
+    }
+
+    std::size_t size() const { return sortedKeys.size(); }
+    std::vector<Key> const& keys() const { return sortedKeys; }
+    std::vector<Value> const& values() const { return sortedValues; }
+
+    // 找到时返回值的指针，否则返回 nullptr
+    Value const* find(Lookup k) const
+    {
+        if constexpr (std::is_integral_v<Key>) {
+            std::size_t i = lowerBound(Search::of(k, 0));
+            return i < size() && sortedKeys[i] == k ? &sortedValues[i] : nullptr;
+        }
+        else {
+            if (size() == 0 || k.compare(0, skip, sortedKeys.front(), 0, skip) != 0) {
+                return nullptr;                         // 没有公共前缀，不可能存在
+            }
+            std::uint64_t p = Search::of(k, skip);
+            std::size_t i = lowerBound(p);
+            // 前缀相同的一段：通常只有一个元素，否则先在搜索键数组上确定范围，再比较完整字符串
+            if (i == size() || prefixes[i] != p) {
+                return nullptr;
+            }
+            if (sortedKeys[i] == k) {
+                return &sortedValues[i];
+            }
+            std::size_t end = std::upper_bound(prefixes.begin() + i, prefixes.end(), p) - prefixes.begin();
+            auto first = sortedKeys.begin() + i;
+            auto last = sortedKeys.begin() + end;
+            auto pos = std::lower_bound(first, last, k, [](Key const& a, Lookup b) { return a < b; });
+            return pos != last && *pos == k ? &sortedValues[pos - sortedKeys.begin()] : nullptr;
+        }
+    }
+
+    bool contains(Lookup k) const { return find(k) != nullptr; }
+
+    template<typename F>
+    void forEach(F f) const
+    {
+        for (std::size_t i = 0; i < size(); ++i) {
+            f(sortedKeys[i], sortedValues[i]);
+        }
+    }
+};
+#endif //CXX_TEMPLATES_FLATMAP_HPP
@@ -0,0 +1,100 @@
+#include "flatmap.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+constexpr std::size_t Lookups = 2'000'000;
+
+// 一半查找命中，一半未命中；输出 ns/次
+template<typename Key, typename Probe>
+void bench(std::size_t n, std::vector<Key> const& present, std::vector<Key> const& absent)
+{
+    std::mt19937_64 rng(n);
+    std::vector<Probe> probes(Lookups);
+    for (std::size_t i = 0; i < Lookups; ++i) {
+        probes[i] = i % 2 == 0 ? Probe(present[rng() % n]) : Probe(absent[rng() % n]);
+    }
+    std::map<Key, double, std::less<>> tree;
+    std::unordered_map<Key, double> hash;
+    FlatMap<Key, double> flat;
+    for (std::size_t i = 0; i < n; ++i) {
+        tree.emplace(present[i], double(i));
+        hash.emplace(present[i], double(i));
+        flat.insert(present[i], double(i));
+    }
+    flat.build();
+
+    double s1 = 0, s2 = 0, s3 = 0;
+    double t1 = measure([&] {
+        for (auto const& p : probes) {
+            auto it = tree.find(p);
+            s1 += it != tree.end() ? it->second : 0;
+        }
+    });
+    double t2 = measure([&] {
+        for (auto const& p : probes) {
+            auto it = hash.find(Key(p));        // C++17 的 unordered_map 不支持异构查找
+            s2 += it != hash.end() ? it->second : 0;
+        }
+    });
+    double t3 = measure([&] {
+        for (auto const& p : probes) {
+            double const* v = flat.find(p);
+            s3 += v != nullptr ? *v : 0;
+        }
+    });
+    std::cout << n << "\t" << t1 / Lookups << "\t\t" << t2 / Lookups << "\t\t" << t3 / Lookups
+              << (s1 == s2 && s2 == s3 ? "" : "\tMISMATCH") << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t maxInts = argc > 1 ? std::stoull(argv[1]) : 10'000'000;
+    std::size_t maxStrings = argc > 2 ? std::stoull(argv[2]) : 1'000'000;
+
+    // errornovel1.cpp 的用法：键数组连续，find_if 不再追逐树节点指针
+    FlatMap<std::string, double> coll;
+    coll.insert("", 0.0);
+    coll.insert("pi", 3.14);
+    coll.build();
+    auto pos = std::find_if(coll.keys().begin(), coll.keys().end(),
+                            [](std::string const& s) { return s != ""; });
+    std::cout << "first non-empty key: " << *pos << ", pi = " << *coll.find("pi") << "\n\n";
+
+    std::mt19937_64 rng(1);
+    std::cout << "uint64 keys, ns per lookup\nentries\tstd::map\tunordered_map\tFlatMap\n";
+    for (std::size_t n = 100; n <= maxInts; n *= 10) {
+        std::vector<std::uint64_t> present(n), absent(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            present[i] = rng() | 1;
+            absent[i] = rng() & ~std::uint64_t(1);
+        }
+        bench<std::uint64_t, std::uint64_t>(n, present, absent);
+    }
+
+    // 形如配置项名的字符串键，有公共前缀；以 std::string_view 查找
+    std::cout << "\nstring keys looked up by string_view, ns per lookup\nentries\tstd::map\tunordered_map\tFlatMap\n";
+    for (std::size_t n = 100; n <= maxStrings; n *= 10) {
+        std::vector<std::string> present(n), absent(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            present[i] = "cfg." + std::to_string(rng() % 1000) + ".key" + std::to_string(2 * i);
+            absent[i] = "cfg." + std::to_string(rng() % 1000) + ".key" + std::to_string(2 * i + 1);
+        }
+        bench<std::string, std::string_view>(n, present, absent);
+    }
+}
@@ -0,0 +1,121 @@
+#include "foreach.hpp"
+#include "functionref.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <numeric>
+#include <vector>
+
+// 统计堆分配次数
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t n)
+{
+    ++allocations;
+    if (void* p = std::malloc(n)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+// 四种传递方式各一个不内联的遍历函数，调用开销不会被内联消除
+template<typename F>
+[[gnu::noinline]] void viaTemplate(std::vector<int>& v, F f)
+{
+    foreach(v.begin(), v.end(), f);
+}
+
+[[gnu::noinline]] void viaRef(std::vector<int>& v, function_ref<void(int&)> f)
+{
+    foreach(v.begin(), v.end(), f);
+}
+
+[[gnu::noinline]] void viaInplace(std::vector<int>& v, inplace_function<void(int&), 64> const& f)
+{
+    foreach(v.begin(), v.end(), f);
+}
+
+[[gnu::noinline]] void viaStd(std::vector<int>& v, std::function<void(int&)> const& f)
+{
+    foreach(v.begin(), v.end(), f);
+}
+
+int add(int a, int b)
+{
+    return a + b;
+}
+
+int main()
+{
+    // call() 的重载：函数、lambda、存储起来的 inplace_function
+    std::cout << "call(add): " << call(function_ref<int(int, int)>(add), 1, 2) << '\n';
+    long total = 0;
+    auto accumulate = [&total](int i) { total += i; };
+    call(function_ref<void(int)>(accumulate), 40);
+    inplace_function<long(int)> stored = [&total](int i) { return total + i; };
+    std::cout << "call(stored): " << call(stored, 2) << '\n';
+
+    // 调用开销：捕获 40 字节，超出 std::function 的内部缓冲区
+    std::vector<int> v(10'000);
+    std::iota(v.begin(), v.end(), 0);
+    long a = 1, b = 2, c = 3, d = 4, sum = 0;
+    long* out = &sum;
+    auto op = [a, b, c, d, out](int& i) { *out += i * a + b - c + d; };
+    constexpr int rounds = 2'000;
+    double ms[4];
+    std::size_t allocs[4];
+    auto run = [&](int k, auto f) {
+        allocations = 0;
+        ms[k] = measure([&] {
+            for (int r = 0; r < rounds; ++r) {
+                f();
+            }
+        });
+        allocs[k] = allocations;
+    };
+    run(0, [&] { viaTemplate(v, op); });
+    run(1, [&] { viaRef(v, op); });
+    run(2, [&] { viaInplace(v, op); });
+    run(3, [&] { viaStd(v, op); });     // 每轮都从 lambda 构造一个 std::function
+    char const* names[] = {"template        ", "function_ref    ", "inplace_function", "std::function   "};
+    for (int k = 0; k < 4; ++k) {
+        std::cout << names[k] << ": " << ms[k] * 1e6 / (double(rounds) * v.size()) << " ns/call, "
+                  << allocs[k] << " allocations\n";
+    }
+
+    // 存储 10000 个回调：std::function 每个都在堆上分配，inplace_function 只有 vector 本身的一次
+    constexpr int n = 10'000;
+    allocations = 0;
+    {
+        std::vector<std::function<void(int&)>> callbacks;
+        callbacks.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            callbacks.emplace_back(op);
+        }
+    }
+    std::cout << "store " << n << " std::function:    " << allocations << " allocations\n";
+    allocations = 0;
+    {
+        std::vector<inplace_function<void(int&), 64>> callbacks;
+        callbacks.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            callbacks.emplace_back(op);
+        }
+    }
+    std::cout << "store " << n << " inplace_function: " << allocations << " allocations\n";
+    std::cout << (sum != 0 && total == 40 ? "" : "MISMATCH\n");
+}
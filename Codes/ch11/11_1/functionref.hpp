@@ -0,0 +1,181 @@
+#ifndef CXX_TEMPLATES_FUNCTIONREF_HPP
+#define CXX_TEMPLATES_FUNCTIONREF_HPP
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// 类型擦除的可调用体，用来代替每个 lambda 一份实例化的模板参数和会在堆上分配的 std::function：
+//   function_ref<R(Args...)>：不拥有可调用体，只保存对象地址和一个调用函数指针（两个指针大小），
+//                            被引用的对象必须比 function_ref 活得久，适合作为参数传递；
+//   inplace_function<R(Args...), Capacity>：拥有可调用体，保存在 Capacity 字节的内部缓冲区中，
+//                            捕获过大时编译报错，永远不在堆上分配，适合存储。
+
+template<typename Sig>
+class function_ref;
+
+template<typename R, typename... Args>
+class function_ref<R(Args...)>
+{
+private:
+    union Target {
+        void const* object;
+        void (*function)();
+    };
+    Target target;
+    R (*thunk)(Target, Args...);
+
+public:
+    template<typename F,
+             typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, function_ref>
+                                         && std::is_invocable_r_v<R, F&, Args...>>>
+    function_ref(F&& f) noexcept
+    {
+        using T = std::remove_reference_t<F>;
+        if constexpr (std::is_function_v<std::remove_pointer_t<std::decay_t<F>>>) {
+            // 函数和函数指针：保存函数指针本身，调用时再转换回来
+            target.function = reinterpret_cast<void (*)()>(static_cast<std::decay_t<F>>(f));
+            thunk = [](Target t, Args... args) -> R {
+                return std::invoke(reinterpret_cast<std::decay_t<F>>(t.function), std::forward<Args>(args)...);
+            };
+        }
+        else {
+            target.object = std::addressof(f);
+            thunk = [](Target t, Args... args) -> R {
+                return std::invoke(*static_cast<T*>(const_cast<void*>(t.object)), std::forward<Args>(args)...);
+            };
+        }
+    }
+
+    R operator()(Args... args) const
+    {
+        return thunk(target, std::forward<Args>(args)...);
+    }
+};
+
+template<typename Sig, std::size_t Capacity = 4 * sizeof(void*)>
+class inplace_function;
+
+template<typename R, typename... Args, std::size_t Capacity>
+class inplace_function<R(Args...), Capacity>
+{
+private:
+    // 每种可调用体类型一张静态操作表
+    struct Ops {
+        R (*invoke)(void*, Args&&...);
+        void (*copy)(void* to, void const* from);
+        void (*move)(void* to, void* from) noexcept;
+        void (*destroy)(void*) noexcept;
+    };
+
+    template<typename F>
+    static constexpr Ops opsFor{
+        [](void* p, Args&&... args) -> R { return std::invoke(*static_cast<F*>(p), std::forward<Args>(args)...); },
+        [](void* to, void const* from) { ::new (to) F(*static_cast<F const*>(from)); },
+        [](void* to, void* from) noexcept { ::new (to) F(std::move(*static_cast<F*>(from))); },
+        [](void* p) noexcept { static_cast<F*>(p)->~F(); },
+    };
+
+    alignas(std::max_align_t) unsigned char buffer[Capacity];
+    Ops const* ops = nullptr;
+
+public:
+    inplace_function() noexcept = default;
+    inplace_function(std::nullptr_t) noexcept {}
+
+    template<typename F,
+             typename D = std::decay_t<F>,
+             typename = std::enable_if_t<!std::is_same_v<D, inplace_function>
+                                         && std::is_invocable_r_v<R, D&, Args...>>>
+    inplace_function(F&& f)
+    {
+        static_assert(sizeof(D) <= Capacity, "inplace_function: callable does not fit into Capacity");
+        static_assert(alignof(D) <= alignof(std::max_align_t), "inplace_function: callable is over-aligned");
+        static_assert(std::is_nothrow_move_constructible_v<D>, "inplace_function: callable must be nothrow movable");
+        ::new (static_cast<void*>(buffer)) D(std::forward<F>(f));
+        ops = &opsFor<D>;
+    }
+
+    inplace_function(inplace_function const& b) : ops(b.ops)
+    {
+        if (ops != nullptr) {
+            ops->copy(buffer, b.buffer);
+        }
+    }
+
+    inplace_function(inplace_function&& b) noexcept : ops(b.ops)
+    {
+        if (ops != nullptr) {
+            ops->move(buffer, b.buffer);
+        }
+    }
+
+    inplace_function& operator=(inplace_function b) noexcept
+    {
+        reset();
+        if (b.ops != nullptr) {
+            b.ops->move(buffer, b.buffer);
+            ops = b.ops;
+        }
+        return *this;
+    }
+
+    ~inplace_function() { reset(); }
+
+    void reset() noexcept
+    {
+        if (ops != nullptr) {
+            ops->destroy(buffer);
+            ops = nullptr;
+        }
+    }
+
+    explicit operator bool() const noexcept { return ops != nullptr; }
+
+    R operator()(Args... args) const
+    {
+        if (ops == nullptr) {
+            throw std::bad_function_call();
+        }
+        return ops->invoke(const_cast<unsigned char*>(buffer), std::forward<Args>(args)...);
+    }
+};
+
+// foreach（foreach.hpp）的重载：传入 function_ref 或 inplace_function 时选中这里，
+// 对同一种迭代器只实例化一次，不再每个 lambda 一份
+template<typename Iter>
+void foreach (Iter current, Iter end,
+              function_ref<void(typename std::iterator_traits<Iter>::reference)> op)
+{
+    while (current != end) {
+        op(*current);
+        ++current;
+    }
+}
+
+template<typename Iter, std::size_t Capacity>
+void foreach (Iter current, Iter end,
+              inplace_function<void(typename std::iterator_traits<Iter>::reference), Capacity> const& op)
+{
+    while (current != end) {
+        op(*current);
+        ++current;
+    }
+}
+
+// call()（invokeret.hpp）的重载：返回类型由签名给出，不必再用 if constexpr 区分 void
+template<typename R, typename... Params, typename... Args>
+R call(function_ref<R(Params...)> op, Args&&... args)
+{
+    return op(std::forward<Args>(args)...);
+}
+
+template<typename R, typename... Params, std::size_t Capacity, typename... Args>
+R call(inplace_function<R(Params...), Capacity> const& op, Args&&... args)
+{
+    return op(std::forward<Args>(args)...);
+}
+#endif //CXX_TEMPLATES_FUNCTIONREF_HPP
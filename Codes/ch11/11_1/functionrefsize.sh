@@ -0,0 +1,52 @@
+#!/bin/sh
+# 代码体积基准：生成把 N 个不同的 lambda 传给排序包装函数 sortBy 的程序，对比
+#   template    ：template<typename Cmp> sortBy(vector<int>&, Cmp)，每个 lambda 各实例化一份 std::sort；
+#   function_ref：sortBy(vector<int>&, function_ref<bool(int, int)>)，只有一份 std::sort，
+#                 每个 lambda 只多出一个很小的转发函数（thunk）。
+# 分别用 -O2 和 -Os 编译，报告 .text 大小。
+# 用法：sh functionrefsize.sh [N] [g++]
+N=${1:-50}
+CXX=${2:-g++}
+DIR=$(cd "$(dirname "$0")" && pwd)
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+seq0() { i=0; while [ $i -lt "$1" ]; do echo $i; i=$((i + 1)); done; }
+
+# 每个 lambda 的比较规则都不同，避免编译器合并相同的实例
+program() {
+    echo "#include <algorithm>"
+    echo "#include <cstdio>"
+    echo "#include <vector>"
+    echo "$1"
+    echo "int main(int argc, char**)"
+    echo "{"
+    echo "    std::vector<int> v(100);"
+    echo "    long r = 0;"
+    for i in $(seq0 "$N"); do
+        echo "    for (std::size_t k = 0; k < v.size(); ++k) { v[k] = static_cast<int>(k * 7919 % 101) + argc; }"
+        echo "    sortBy(v, [](int a, int b) { return (a ^ $i) < (b ^ $i); });"
+        echo "    r += v[$((i % 100))];"
+    done
+    cat <<'EOT'
+    std::printf("%ld\n", r);
+}
+EOT
+}
+
+program "template<typename Cmp>
+void sortBy(std::vector<int>& v, Cmp cmp) { std::sort(v.begin(), v.end(), cmp); }" > "$TMP/template.cpp"
+program "#include \"$DIR/functionref.hpp\"
+[[gnu::noinline]] void sortBy(std::vector<int>& v, function_ref<bool(int, int)> cmp)
+{ std::sort(v.begin(), v.end(), cmp); }" > "$TMP/function_ref.cpp"
+
+echo "| variant | -O2 .text bytes | -Os .text bytes |"
+echo "|---|---|---|"
+for v in template function_ref; do
+    row="| $v |"
+    for opt in -O2 -Os; do
+        $CXX -std=c++17 $opt -DNDEBUG "$TMP/$v.cpp" -o "$TMP/$v" || exit 1
+        row="$row $(size "$TMP/$v" | awk 'NR == 2 { print $1 }') |"
+    done
+    echo "$row"
+done
@@ -0,0 +1,236 @@
+#include "collection.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+struct Item {               // 40 字节：落在 48 字节级别
+    long key;
+    double weight;
+    char tag[24];
+};
+
+// 统计上游申请字节数的 memory_resource，用来衡量 pmr 池的占用
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::atomic<std::size_t> bytes{0};
+private:
+    void* do_allocate(std::size_t n, std::size_t a) override {
+        bytes += n;
+        return ::operator new(n, std::align_val_t(a));
+    }
+    void do_deallocate(void* p, std::size_t n, std::size_t a) override {
+        bytes -= n;
+        ::operator delete(p, n, std::align_val_t(a));
+    }
+    bool do_is_equal(memory_resource const& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// 每个线程维持 Live 个存活对象，随机替换其中一个，共 Ops 次分配和释放
+constexpr std::size_t Live = 4096;
+constexpr std::size_t Ops = 1'000'000;
+
+template<typename Alloc, typename Free>
+void churn(unsigned seed, Alloc alloc, Free free)
+{
+    std::vector<Item*> live(Live);
+    for (auto& p : live) {
+        p = alloc();
+        p->key = 0;
+    }
+    std::minstd_rand rng(seed);
+    for (std::size_t i = 0; i < Ops; ++i) {
+        Item*& p = live[rng() % Live];
+        free(p);
+        p = alloc();
+        p->key = static_cast<long>(i);
+    }
+    for (auto p : live) {
+        free(p);
+    }
+}
+
+template<typename F>
+double runThreads(unsigned threads, F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back(f, t);
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+    return threads * Ops / d.count() / 1e6;         // 百万次分配+释放每秒
+}
+
+std::size_t heapBytes()
+{
+#ifdef __GLIBC__
+    struct mallinfo2 mi = mallinfo2();
+    return mi.arena + mi.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+// 碎片：分配 n 个对象后随机释放一半，再申请 n/2 个 Item 两倍大小的对象，
+// 报告系统占用字节数 / 存活字节数
+void fragmentation()
+{
+    constexpr std::size_t n = 1'000'000;
+    struct Big { Item a, b; };
+    std::mt19937 rng(7);
+    auto report = [](char const* name, std::size_t reserved, std::size_t liveBytes) {
+        std::cout << "  " << name << ": reserved " << reserved / 1024 << " KiB, live "
+                  << liveBytes / 1024 << " KiB, ratio " << double(reserved) / liveBytes << '\n';
+    };
+    std::size_t const liveBytes = n / 2 * sizeof(Item) + n / 2 * sizeof(Big);
+    std::cout << "fragmentation after freeing every other object and allocating larger ones:\n";
+    {
+        Collection coll;
+        std::vector<Item*> items(n);
+        for (auto& p : items) {
+            p = coll.alloc<Item>();
+        }
+        std::shuffle(items.begin(), items.end(), rng);
+        for (std::size_t i = 0; i < n / 2; ++i) {
+            coll.free(items[i]);
+        }
+        std::vector<Big*> bigs(n / 2);
+        for (auto& p : bigs) {
+            p = coll.alloc<Big>();
+        }
+        report("Collection", coll.reservedBytes(), liveBytes);
+    }
+    {
+        std::size_t before = heapBytes();
+        std::vector<Item*> items(n);
+        for (auto& p : items) {
+            p = new Item;
+        }
+        std::shuffle(items.begin(), items.end(), rng);
+        for (std::size_t i = 0; i < n / 2; ++i) {
+            delete items[i];
+        }
+        std::vector<Big*> bigs(n / 2);
+        for (auto& p : bigs) {
+            p = new Big;
+        }
+        report("new/delete", heapBytes() - before, liveBytes);
+        for (std::size_t i = n / 2; i < n; ++i) {
+            delete items[i];
+        }
+        for (auto p : bigs) {
+            delete p;
+        }
+    }
+    {
+        CountingResource upstream;
+        std::pmr::unsynchronized_pool_resource pool(&upstream);
+        std::vector<void*> items(n);
+        for (auto& p : items) {
+            p = pool.allocate(sizeof(Item), alignof(Item));
+        }
+        std::shuffle(items.begin(), items.end(), rng);
+        for (std::size_t i = 0; i < n / 2; ++i) {
+            pool.deallocate(items[i], sizeof(Item), alignof(Item));
+        }
+        std::vector<void*> bigs(n / 2);
+        for (auto& p : bigs) {
+            p = pool.allocate(sizeof(Big), alignof(Big));
+        }
+        report("pmr pool", upstream.bytes, liveBytes);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned maxThreads = argc > 1 ? std::atoi(argv[1]) : 32;
+
+    // 正确性：不同线程分配、交叉释放后，所有对象内容互不覆盖
+    {
+        Collection coll;
+        std::vector<Item*> a(10000), b(10000);
+        std::thread t([&] {
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                a[i] = coll.create<Item>();
+                a[i]->key = long(i);
+            }
+        });
+        t.join();
+        for (std::size_t i = 0; i < b.size(); ++i) {
+            b[i] = coll.create<Item>();
+            b[i]->key = -long(i) - 1;
+        }
+        bool ok = true;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            ok = ok && a[i]->key == long(i) && b[i]->key == -long(i) - 1;
+        }
+        std::thread u([&] {
+            for (auto p : b) {
+                coll.destroy(p);
+            }
+        });
+        u.join();
+        for (auto p : a) {
+            coll.destroy(p);
+        }
+        auto* s = coll.create<std::string>(100, 'x');     // 32 字节，非平凡类型
+        ok = ok && s->size() == 100;
+        coll.destroy(s);
+        // 退出的两个线程已经把 magazine 还回来，只剩主线程的
+        ok = ok && coll.threadCount() == 1;
+        // 超过最大级别、对齐要求超过 16 字节的对象：不释放，由 Collection 析构时释放（ASan 下无泄漏）
+        struct Huge { char bytes[8192]; };
+        struct alignas(64) Wide { char bytes[64]; };
+        coll.alloc<Huge>();
+        coll.alloc<Wide>();
+        coll.free(coll.alloc<Wide>());
+        std::cout << "cross-thread check: " << (ok ? "ok" : "FAILED") << '\n';
+    }
+
+    // 一个线程交替使用两个 Collection：每次切换只查本线程的表，不加锁
+    {
+        Collection a, b;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < Ops; ++i) {
+            Collection& c = i % 2 ? a : b;
+            c.free(c.alloc<Item>());
+        }
+        std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+        std::cout << "alternating two collections: " << Ops / d.count() / 1e6 << " M alloc+free per second\n";
+    }
+
+    std::cout << "throughput (M alloc+free per second, " << Live << " live objects per thread):\n"
+              << "threads  Collection  new/delete  pmr pool\n";
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        Collection coll;
+        double c = runThreads(threads, [&](unsigned t) {
+            churn(t, [&] { return coll.alloc<Item>(); }, [&](Item* p) { coll.free(p); });
+        });
+        double n = runThreads(threads, [](unsigned t) {
+            churn(t, [] { return new Item; }, [](Item* p) { delete p; });
+        });
+        // unsynchronized_pool_resource 不是线程安全的，每个线程一个
+        double r = runThreads(threads, [](unsigned t) {
+            std::pmr::unsynchronized_pool_resource pool;
+            std::pmr::polymorphic_allocator<Item> a(&pool);
+            churn(t, [&] { return a.allocate(1); }, [&](Item* p) { a.deallocate(p, 1); });
+        });
+        std::cout << threads << "\t " << c << "\t     " << n << "\t " << r << '\n';
+    }
+
+    fragmentation();
+}
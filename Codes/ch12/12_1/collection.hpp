@@ -0,0 +1,314 @@
+#ifndef CXX_TEMPLATES_COLLECTION_HPP
+#define CXX_TEMPLATES_COLLECTION_HPP
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// definitions2.hpp 中 Collection 的完整实现：alloc<T>() 是一个按大小分级的 slab 分配器。
+//   - 每个 T 按 sizeof(Node<T>) 落到一个大小级别，同一级别的类型共享 slab；
+//   - 空闲块用侵入式链表串起来（空闲时 Node<T> 的存储区里放 next 指针）；
+//   - 每个线程每个级别有一个 magazine（指针数组），分配和释放只碰本线程的 magazine，
+//     空了从共享的 depot 批量补充，满了批量归还给 depot；线程退出时 magazine 整个还给 depot；
+//   - Collection 析构时整块释放所有 slab，仍然存活的对象不会调用析构函数。
+// 超过最大级别或对齐要求超过 16 字节的类型直接交给 ::operator new，但仍然记录下来，
+// 同样在 Collection 析构时释放。
+
+class Collection {
+public:
+    template<typename T>    // 类内部成员类模板定义：一个 slab 槽位
+    class Node {
+    private:
+        // 使用时是 T 的存储区；空闲时由 depot 当作 FreeNode 串进侵入式链表
+        alignas(T) unsigned char storage[sizeof(T)];
+    public:
+        T* object() { return reinterpret_cast<T*>(storage); }
+        static Node* from(T* p) { return reinterpret_cast<Node*>(p); }
+    };
+
+    template<typename T>    // 类内部（或者成为隐式 inline）成员函数模板定义：未初始化的存储
+    T *alloc() {
+        constexpr std::size_t c = classOf(sizeof(Node<T>), alignof(Node<T>));
+        if constexpr (c == NumClasses) {
+            return static_cast<T*>(allocLarge(sizeof(T), alignof(T)));
+        }
+        else {
+            return static_cast<Node<T>*>(allocSlot(c))->object();
+        }
+    }
+
+    template<typename T>    // 归还 alloc<T>() 得到的存储，不调用析构函数
+    void free(T* p) {
+        constexpr std::size_t c = classOf(sizeof(Node<T>), alignof(Node<T>));
+        if constexpr (c == NumClasses) {
+            freeLarge(p, alignof(T));
+        }
+        else {
+            freeSlot(c, Node<T>::from(p));
+        }
+    }
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args) {
+        T* p = alloc<T>();
+        try {
+            return ::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            free(p);
+            throw;
+        }
+    }
+
+    template<typename T>
+    void destroy(T* p) {
+        p->~T();
+        free(p);
+    }
+
+    template<typename T>    // 一个成员变量模板（自C++14开始支持）
+    static inline T zero = 0;
+
+    template<typename T>    // 一个类内部的成员别名模板
+    using NodePtr = Node<T>*;
+
+    Collection() {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        registry().emplace(serial, this);
+    }
+    Collection(Collection const&) = delete;
+    Collection& operator=(Collection const&) = delete;
+
+    ~Collection() {
+        {
+            // 之后退出的线程不会再把 magazine 还给这个 Collection
+            std::lock_guard<std::mutex> lock(registryMutex());
+            registry().erase(serial);
+        }
+        for (Depot& d : depots) {
+            for (void* slab : d.slabs) {
+                ::operator delete(slab);
+            }
+        }
+        for (auto const& [p, align] : large) {
+            ::operator delete(p, std::align_val_t(align));
+        }
+    }
+
+    // 从系统申请的 slab 总字节数，用于衡量碎片
+    std::size_t reservedBytes() const {
+        return reserved.load(std::memory_order_relaxed);
+    }
+
+    // 持有 magazine 的线程数：用过这个 Collection 且尚未退出的线程
+    std::size_t threadCount() {
+        std::lock_guard<std::mutex> lock(cachesMutex);
+        return caches.size();
+    }
+
+private:
+    // 级别：16 字节步长到 128，之后每级约 1.5 倍，最大 4096
+    static constexpr std::size_t ClassSizes[] = {
+        16, 32, 48, 64, 80, 96, 112, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096
+    };
+    static constexpr std::size_t NumClasses = std::size(ClassSizes);
+    static constexpr std::size_t SlabBytes = 64 * 1024;
+    static constexpr unsigned MagazineSize = 64;
+    static constexpr unsigned BatchSize = MagazineSize / 2;
+
+    static constexpr std::size_t classOf(std::size_t size, std::size_t align) {
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return NumClasses;
+        }
+        std::size_t c = 0;
+        while (c < NumClasses && ClassSizes[c] < size) {
+            ++c;
+        }
+        return c;
+    }
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    // 每个级别一个，所有线程共享
+    struct Depot {
+        std::mutex mutex;
+        std::vector<FreeNode*> batches;     // 每批 BatchSize 个空闲块，用侵入式链表串起来
+        std::vector<void*> slabs;
+        char* cursor = nullptr;             // 当前 slab 中尚未切分的部分
+        char* end = nullptr;
+    };
+
+    struct Magazine {
+        void* items[MagazineSize];
+        unsigned count = 0;
+    };
+
+    struct ThreadCache {
+        Magazine magazines[NumClasses];
+    };
+
+    Depot depots[NumClasses];
+    std::atomic<std::size_t> reserved{0};
+    std::mutex cachesMutex;
+    std::unordered_map<std::thread::id, std::unique_ptr<ThreadCache>> caches;
+    std::mutex largeMutex;
+    std::unordered_map<void*, std::size_t> large;      // 直接向 ::operator new 申请的块及其对齐
+    // 全局递增的序号，不会被后来的 Collection 重用，线程局部缓存据此判断是否失效
+    std::uint64_t const serial = nextSerial().fetch_add(1, std::memory_order_relaxed) + 1;
+
+    static std::atomic<std::uint64_t>& nextSerial() {
+        static std::atomic<std::uint64_t> n{0};
+        return n;
+    }
+
+    // 仍然存在的 Collection：序号 -> 对象。退出的线程据此判断 magazine 还能还给谁
+    static std::unordered_map<std::uint64_t, Collection*>& registry() {
+        static std::unordered_map<std::uint64_t, Collection*> r;
+        return r;
+    }
+    static std::mutex& registryMutex() {
+        static std::mutex m;
+        return m;
+    }
+
+    // 一个线程用过的所有 Collection 中的 magazine：最近使用的直接命中，否则查表。
+    // 线程退出时析构，把 magazine 还给仍然存在的 Collection
+    struct ThreadCaches {
+        std::uint64_t lastSerial = 0;
+        ThreadCache* last = nullptr;
+        std::unordered_map<std::uint64_t, ThreadCache*> known;
+
+        ~ThreadCaches() {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            for (auto const& [serial, cache] : known) {
+                auto it = registry().find(serial);
+                if (it != registry().end()) {
+                    it->second->release(cache);
+                }
+            }
+        }
+    };
+
+    // 当前线程在本 Collection 中的 magazine：只有第一次使用某个 Collection 时才加锁注册，
+    // 交替使用多个 Collection 不需要加锁（与 asynclog.hpp 中 localRing() 的做法相同）
+    ThreadCache& threadCache() {
+        thread_local ThreadCaches tc;
+        if (tc.lastSerial != serial) {
+            ThreadCache*& cache = tc.known[serial];
+            if (cache == nullptr) {
+                std::lock_guard<std::mutex> lock(cachesMutex);
+                auto& p = caches[std::this_thread::get_id()];
+                p = std::make_unique<ThreadCache>();
+                cache = p.get();
+            }
+            tc.lastSerial = serial;
+            tc.last = cache;
+        }
+        return *tc.last;
+    }
+
+    // 退出的线程：magazine 中的空闲块按批还给 depot，然后删除它的 ThreadCache
+    void release(ThreadCache* cache) {
+        for (std::size_t c = 0; c < NumClasses; ++c) {
+            Magazine& m = cache->magazines[c];
+            while (m.count != 0) {
+                FreeNode* head = nullptr;
+                for (unsigned i = 0; i < BatchSize && m.count != 0; ++i) {
+                    FreeNode* n = static_cast<FreeNode*>(m.items[--m.count]);
+                    n->next = head;
+                    head = n;
+                }
+                std::lock_guard<std::mutex> lock(depots[c].mutex);
+                depots[c].batches.push_back(head);
+            }
+        }
+        std::lock_guard<std::mutex> lock(cachesMutex);
+        caches.erase(std::this_thread::get_id());
+    }
+
+    void* allocLarge(std::size_t size, std::size_t align) {
+        void* p = ::operator new(size, std::align_val_t(align));
+        try {
+            std::lock_guard<std::mutex> lock(largeMutex);
+            large.emplace(p, align);
+        }
+        catch (...) {
+            ::operator delete(p, std::align_val_t(align));
+            throw;
+        }
+        return p;
+    }
+
+    void freeLarge(void* p, std::size_t align) {
+        {
+            std::lock_guard<std::mutex> lock(largeMutex);
+            large.erase(p);
+        }
+        ::operator delete(p, std::align_val_t(align));
+    }
+
+    void* allocSlot(std::size_t c) {
+        Magazine& m = threadCache().magazines[c];
+        if (m.count == 0) {
+            refill(c, m);
+        }
+        return m.items[--m.count];
+    }
+
+    void freeSlot(std::size_t c, void* p) {
+        Magazine& m = threadCache().magazines[c];
+        if (m.count == MagazineSize) {
+            flush(c, m);
+        }
+        m.items[m.count++] = p;
+    }
+
+    // magazine 为空：优先取 depot 中别的线程归还的一批，否则从 slab 切一批
+    void refill(std::size_t c, Magazine& m) {
+        Depot& d = depots[c];
+        std::lock_guard<std::mutex> lock(d.mutex);
+        if (!d.batches.empty()) {
+            FreeNode* head = d.batches.back();
+            d.batches.pop_back();
+            for (FreeNode* n = head; n != nullptr; n = n->next) {
+                m.items[m.count++] = n;
+            }
+            return;
+        }
+        std::size_t const size = ClassSizes[c];
+        if (static_cast<std::size_t>(d.end - d.cursor) < size * BatchSize) {
+            std::size_t bytes = std::max(SlabBytes, size * BatchSize);
+            d.slabs.push_back(::operator new(bytes));
+            d.cursor = static_cast<char*>(d.slabs.back());
+            d.end = d.cursor + bytes;
+            reserved.fetch_add(bytes, std::memory_order_relaxed);
+        }
+        for (unsigned i = 0; i < BatchSize; ++i, d.cursor += size) {
+            m.items[m.count++] = d.cursor;
+        }
+    }
+
+    // magazine 已满：把后一半串成链表交给 depot，留一半应付接下来的分配
+    void flush(std::size_t c, Magazine& m) {
+        FreeNode* head = nullptr;
+        for (unsigned i = 0; i < BatchSize; ++i) {
+            FreeNode* n = static_cast<FreeNode*>(m.items[--m.count]);
+            n->next = head;
+            head = n;
+        }
+        Depot& d = depots[c];
+        std::lock_guard<std::mutex> lock(d.mutex);
+        d.batches.push_back(head);
+    }
+};
+#endif //CXX_TEMPLATES_COLLECTION_HPP
@@ -0,0 +1,92 @@
+#ifndef CXX_TEMPLATES_RELOCATABLE_HPP
+#define CXX_TEMPLATES_RELOCATABLE_HPP
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// 与 definitions1.hpp 中 Data<T>::copyable / dataCopyable<T> 同一思路的类型能力特征：
+// 若“移动构造到新地址 + 销毁旧对象”等价于按字节复制，则 T 是可平凡重定位的（trivially relocatable）。
+// 平凡可复制的类型自动满足；其他类型（大多数持有堆指针的类，如 std::unique_ptr）需要显式声明：
+//     template<> struct is_trivially_relocatable<MyType> : std::true_type {};
+// 注意 libstdc++ 的 std::string 带有指向自身内部缓冲区的指针（SSO），不能声明为可平凡重定位。
+
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// 标准库智能指针只持有指针（和无状态删除器），主流实现都可以按字节搬移
+template<typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+template<typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+// 重定位不会抛出异常：按字节搬移，或者逐个 noexcept 移动构造再析构
+template<typename T>
+constexpr bool is_nothrow_relocatable_v = is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+// 把 [first, first + n) 中的对象重定位到未初始化的 dest，两段内存不重叠。
+// 之后源位置不再有对象，调用者不能再对它们调用析构函数。
+// 移动构造可能抛出异常的类型改为先全部拷贝构造，成功后再析构源对象；
+// 拷贝抛出异常时销毁已构造的部分并重新抛出，源对象保持不变（强异常安全保证）。
+template<typename T>
+void relocate(T* first, std::size_t n, T* dest)
+{
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (n != 0) {
+            std::memcpy(static_cast<void*>(dest), static_cast<void const*>(first), n * sizeof(T));
+        }
+    }
+    else if constexpr (std::is_nothrow_move_constructible_v<T>) {
+        for (std::size_t i = 0; i < n; ++i) {
+            ::new (static_cast<void*>(dest + i)) T(std::move(first[i]));
+            first[i].~T();
+        }
+    }
+    else {
+        std::size_t i = 0;
+        try {
+            for (; i < n; ++i) {
+                ::new (static_cast<void*>(dest + i)) T(std::move_if_noexcept(first[i]));
+            }
+        }
+        catch (...) {
+            std::destroy(dest, dest + i);
+            throw;
+        }
+        std::destroy(first, first + n);
+    }
+}
+
+// 同上，但两段内存可以重叠（用于在同一块存储内整体前移或后移）。
+// 重叠时无法在失败后恢复原状，因此只用于重定位不会抛出异常的类型；
+// 其他类型由调用者改为拷贝到另一块存储，成功后再替换原来的内容。
+template<typename T>
+void relocateOverlapping(T* first, std::size_t n, T* dest)
+{
+    static_assert(is_nothrow_relocatable_v<T>,
+                  "relocateOverlapping() requires trivially relocatable or nothrow movable types");
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (n != 0) {
+            std::memmove(static_cast<void*>(dest), static_cast<void const*>(first), n * sizeof(T));
+        }
+    }
+    else if (dest < first) {
+        for (std::size_t i = 0; i < n; ++i) {
+            ::new (static_cast<void*>(dest + i)) T(std::move(first[i]));
+            first[i].~T();
+        }
+    }
+    else {
+        for (std::size_t i = n; i-- > 0;) {
+            ::new (static_cast<void*>(dest + i)) T(std::move(first[i]));
+            first[i].~T();
+        }
+    }
+}
+#endif //CXX_TEMPLATES_RELOCATABLE_HPP
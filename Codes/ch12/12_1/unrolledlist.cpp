@@ -0,0 +1,227 @@
+#include "unrolledlist.hpp"
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+// 拷贝与移动都可能抛出异常的元素：countdown 减到 0 时抛出，用于检查块内移动的异常安全
+int countdown = -1;
+struct Fragile
+{
+    int v;
+    Fragile(int v) : v(v) {}
+    Fragile(Fragile const& o) : v(o.v) { tick(); }
+    Fragile(Fragile&& o) : v(o.v) { tick(); }
+    Fragile& operator=(Fragile const& o) { tick(); v = o.v; return *this; }
+    Fragile& operator=(Fragile&& o) { tick(); v = o.v; return *this; }
+    static void tick()
+    {
+        if (countdown > 0 && --countdown == 0) {
+            throw 0;
+        }
+    }
+};
+
+// 构造函数可能抛出异常、移动不会抛出的元素：走块内直接重定位的路径
+struct Picky
+{
+    int v;
+    Picky(int v) : v(v)
+    {
+        if (v < 0) {
+            throw 0;
+        }
+    }
+};
+
+template<typename L>
+std::size_t walk(L const& l)
+{
+    std::size_t n = 0;
+    for (auto it = l.begin(); it != l.end() && n <= l.size(); ++it) {
+        ++n;
+    }
+    return n;
+}
+
+// 在第 k 次拷贝/移动时抛出，之后链表仍然可以遍历、计数一致，已有的 Handle 仍然有效
+bool checkThrowing()
+{
+    bool ok = true;
+    for (int k = 1; k < 200; ++k) {
+        List<Fragile> l;
+        auto first = l.push_back(Fragile(-1));
+        auto mid = first;
+        int inserted = 1;
+        countdown = k;
+        try {
+            for (int i = 0; i < 100; ++i) {
+                mid = l.insert(mid, Fragile(i));
+                ++inserted;
+                if (i % 7 == 3) {
+                    l.erase(mid);
+                    --inserted;
+                    mid = first;
+                }
+            }
+            l.compact();
+        }
+        catch (int) {
+        }
+        countdown = -1;
+        std::size_t n = 0;
+        for (auto const& x : l) {
+            (void)x;
+            ++n;
+        }
+        ok = ok && n == l.size() && static_cast<int>(n) == inserted && l.get(first) && l.get(first)->v == -1;
+
+        // push_back 在需要新块时失败：新块不能留在链表中
+        List<Fragile> b;
+        std::size_t pushed = 0;
+        countdown = k;
+        try {
+            for (int i = 0; i < 40; ++i) {
+                b.push_back(Fragile(i));
+                ++pushed;
+            }
+        }
+        catch (int) {
+        }
+        countdown = -1;
+        ok = ok && walk(b) == pushed && b.size() == pushed;
+    }
+
+    List<Picky> p;
+    for (int i = 0; i < 16; ++i) {
+        p.emplace_back(i);
+    }
+    List<Picky> e;
+    for (List<Picky>* l : {&p, &e}) {
+        try {
+            l->emplace_back(-1);                        // p 的块已满，e 为空：都要先取新块
+            ok = false;
+        }
+        catch (int) {
+        }
+    }
+    ok = ok && walk(p) == 16 && walk(e) == 0;
+    p.emplace_back(16);
+    ok = ok && walk(p) == 17 && p.blockCount() == 2;
+    return ok;
+}
+
+void check()
+{
+    List<std::string> names;
+    auto a = names.push_back("alice");
+    auto c = names.push_back("carol");
+    auto b = names.insert(c, "bob");
+    for (int i = 0; i < 100; ++i) {
+        names.insert(b, "x" + std::to_string(i));       // 多次分裂块
+    }
+    bool ok = *names.get(a) == "alice" && *names.get(b) == "bob" && *names.get(c) == "carol";
+    names.erase(a);
+    List<std::string>::Handle<std::string const> ro = b;
+    ok = ok && names.get(a) == nullptr && !names.erase(a) && *names.get(ro) == "bob";
+    auto d = names.push_back("dave");                   // 重用 a 的槽位，但代数不同
+    ok = ok && names.get(a) == nullptr && *names.get(d) == "dave";
+    std::size_t before = names.blockCount();
+    names.compact();
+    ok = ok && names.blockCount() <= before && *names.get(b) == "bob" && *names.get(c) == "carol"
+         && names.size() == 103 && *names.begin() == "x0";
+
+    List<int> ints;
+    auto h = ints.push_back(1);
+    ints.push_back(2);
+    List<double> doubles(ints);                         // 逐块转换
+    double sum = 0;
+    for (double v : doubles) {
+        sum += v;
+    }
+    ok = ok && sum == 3 && *ints.get(h) == 1;
+
+    // 移动后的源对象是空链表，可以继续使用；Handle 随元素一起转移
+    List<int> moved = std::move(ints);
+    ok = ok && ints.empty() && ints.begin() == ints.end() && *moved.get(h) == 1 && moved.size() == 2;
+    auto h2 = ints.push_back(2);
+    ints.push_back(3);
+    ok = ok && ints.size() == 2 && *ints.get(h2) == 2;
+    ints = std::move(moved);
+    ok = ok && ints.size() == 2 && *ints.get(h) == 1;
+    ok = ok && checkThrowing();
+    std::cout << "handle checks: " << (ok ? "ok" : "FAILED") << '\n';
+}
+
+int main()
+{
+    check();
+
+    constexpr int N = 1'000'000;
+    std::mt19937 rng(42);
+
+    // 两种容器都先顺序插入，再在随机位置插入和删除 N/2 次，使 std::list 的节点在堆上打散
+    List<int> ul;
+    std::list<int> sl;
+    std::vector<List<int>::Handle<>> handles;
+    std::vector<std::list<int>::iterator> iters;
+    double ulBuild = measure([&] {
+        for (int i = 0; i < N; ++i) {
+            handles.push_back(ul.push_back(i));
+        }
+        for (int i = 0; i < N / 2; ++i) {
+            std::size_t k = rng() % N;
+            std::size_t at = (k + 1 + rng() % (N - 1)) % N;
+            ul.erase(handles[k]);
+            handles[k] = ul.insert(handles[at], i);
+        }
+    });
+    rng.seed(42);
+    double slBuild = measure([&] {
+        for (int i = 0; i < N; ++i) {
+            iters.push_back(sl.insert(sl.end(), i));
+        }
+        for (int i = 0; i < N / 2; ++i) {
+            std::size_t k = rng() % N;
+            std::size_t at = (k + 1 + rng() % (N - 1)) % N;
+            sl.erase(iters[k]);
+            iters[k] = sl.insert(iters[at], i);
+        }
+    });
+
+    long long s1 = 0, s2 = 0, s3 = 0;
+    double ulIter = measure([&] { ul.forEach([&](int v) { s1 += v; }); });
+    double ulRange = measure([&] { for (int v : ul) s2 += v; });
+    double slIter = measure([&] { for (int v : sl) s3 += v; });
+
+    std::vector<std::size_t> order(N);
+    for (auto& k : order) {
+        k = rng() % N;
+    }
+    long long r1 = 0, r2 = 0;
+    double ulRandom = measure([&] { for (auto k : order) r1 += *ul.get(handles[k]); });
+    double slRandom = measure([&] { for (auto k : order) r2 += *iters[k]; });
+    double compactMs = measure([&] { ul.compact(); });
+    long long s4 = 0;
+    double ulPacked = measure([&] { ul.forEach([&](int v) { s4 += v; }); });
+
+    std::cout << N << " ints after " << N / 2 << " random erase+insert\n"
+              << "build:            List " << ulBuild << " ms, std::list " << slBuild << " ms\n"
+              << "iterate:          List forEach " << ulIter << " ms, range-for " << ulRange
+              << " ms, std::list " << slIter << " ms\n"
+              << "random access:    List handle " << ulRandom << " ms, std::list iterator "
+              << slRandom << " ms\n"
+              << "compact:          " << compactMs << " ms, then forEach " << ulPacked << " ms\n"
+              << "checksums: " << (s1 == s2 && s2 == s3 && s3 == s4 && r1 == r2 ? "equal" : "DIFFER") << '\n';
+}
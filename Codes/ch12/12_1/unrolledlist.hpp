@@ -0,0 +1,521 @@
+#ifndef CXX_TEMPLATES_UNROLLEDLIST_HPP
+#define CXX_TEMPLATES_UNROLLEDLIST_HPP
+#include "relocatable.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// definitions3.hpp 中 List<T> 的完整实现：展开链表（unrolled list）+ 槽位映射（slot map）。
+//   - 元素按顺序存放在块中，每块的元素区约为一条缓存行（至少 4 个元素），块之间双向链接；
+//   - Handle 不是指针，而是 32 位槽位下标 + 32 位代数。槽位记录元素当前所在的块和位置，
+//     元素在块内移动、分裂到新块或 compact() 时只需更新槽位，已有的 Handle 仍然有效；
+//   - 删除元素时槽位代数加一，旧 Handle 访问得到 nullptr，而不是悬空指针。
+
+template<typename T>        // 一个命名空间范围内的类模板
+class List {
+private:
+    using Index = std::uint32_t;
+    static constexpr Index npos = ~Index(0);
+    static constexpr std::size_t CacheLine = 64;
+    static constexpr Index BlockSize = static_cast<Index>(std::max<std::size_t>(4, CacheLine / sizeof(T)));
+
+    struct Block {
+        alignas(T) unsigned char storage[BlockSize * sizeof(T)];
+        Index slots[BlockSize];             // 每个位置上的元素对应的槽位
+        Index count = 0;
+        Index prev = npos;
+        Index next = npos;
+
+        // 已有元素的位置；在空位置上构造时用 raw()
+        T* at(Index pos) { return std::launder(reinterpret_cast<T*>(storage) + pos); }
+        T* raw(Index pos) { return reinterpret_cast<T*>(storage) + pos; }
+        ~Block() {
+            for (Index i = 0; i < count; ++i) {
+                at(i)->~T();
+            }
+        }
+    };
+
+    struct Slot {
+        Index block;                        // 使用中：所在块；空闲：下一个空闲槽位
+        Index pos;
+        Index generation = 0;
+        bool used = false;
+    };
+
+    std::vector<std::unique_ptr<Block>> blocks;
+    std::vector<Index> freeBlocks;
+    std::vector<Slot> slots;
+    Index freeSlot = npos;
+    Index head = npos;
+    Index tail = npos;
+    std::size_t count = 0;
+
+    template<typename> friend class List;
+
+public:
+    List() = default;       // 模板构造函数定义
+
+    template<typename U = T>    // 一个成员类模版：U 为 T 或 T const
+    class Handle;
+
+    template<typename U>    // 一个成员函数模板（构造函数）
+    List(List<U> const&);
+
+    List(List const& b) : List() { copyFrom(b); }
+    List(List&& b) noexcept : List() { swap(b); }     // 源对象成为空链表，可以继续使用
+    List& operator=(List b) noexcept {
+        swap(b);
+        return *this;
+    }
+
+    template<typename U>    // 一个成员变量模板（自C++14开始支持）
+    static U zero;
+
+    void swap(List& b) noexcept {
+        std::swap(blocks, b.blocks);
+        std::swap(freeBlocks, b.freeBlocks);
+        std::swap(slots, b.slots);
+        std::swap(freeSlot, b.freeSlot);
+        std::swap(head, b.head);
+        std::swap(tail, b.tail);
+        std::swap(count, b.count);
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    template<typename... Args>
+    Handle<T> emplace_back(Args&&... args) {
+        if (tail == npos || blocks[tail]->count == BlockSize) {
+            // 构造失败时撤下新块：链表中不能留下空块，迭代器无法越过它
+            linkAfter(tail, newBlock());
+            try {
+                return emplaceAt(tail, 0, std::forward<Args>(args)...);
+            }
+            catch (...) {
+                unlink(tail);
+                throw;
+            }
+        }
+        return emplaceAt(tail, blocks[tail]->count, std::forward<Args>(args)...);
+    }
+
+    Handle<T> push_back(T const& value) { return emplace_back(value); }
+    Handle<T> push_back(T&& value) { return emplace_back(std::move(value)); }
+
+    // 在 pos 所指元素之前插入，pos 必须有效；块满时先对半分裂
+    template<typename U, typename... Args>
+    Handle<T> emplace(Handle<U> pos, Args&&... args) {
+        Slot const& s = slots[pos.index];
+        Index b = s.block;
+        Index p = s.pos;
+        if (blocks[b]->count == BlockSize) {
+            Index nb = split(b);
+            if (p >= blocks[b]->count) {
+                p -= blocks[b]->count;
+                b = nb;
+            }
+        }
+        return emplaceAt(b, p, std::forward<Args>(args)...);
+    }
+
+    template<typename U>
+    Handle<T> insert(Handle<U> pos, T const& value) { return emplace(pos, value); }
+
+    // 删除 h 所指元素，h 已失效时返回 false
+    template<typename U>
+    bool erase(Handle<U> h) {
+        if (!valid(h)) {
+            return false;
+        }
+        Slot& s = slots[h.index];
+        Index b = s.block;
+        if constexpr (is_nothrow_relocatable_v<T>) {
+            Block& blk = *blocks[b];
+            blk.at(s.pos)->~T();
+            if (s.pos + 1 < blk.count) {
+                relocateOverlapping(blk.at(s.pos + 1), blk.count - s.pos - 1, blk.raw(s.pos));
+            }
+        }
+        else {
+            // 移动可能抛出异常：把其余元素拷贝到新块，成功后替换原块，抛出时链表保持不变
+            Block& from = *blocks[b];
+            Index nb = newBlock();
+            Block& to = *blocks[nb];
+            T* out = to.raw(0);
+            try {
+                out = std::uninitialized_copy(from.at(0), from.at(0) + s.pos, out);
+                std::uninitialized_copy(from.at(0) + s.pos + 1, from.at(0) + from.count, out);
+            }
+            catch (...) {
+                std::destroy(to.raw(0), out);
+                freeBlocks.push_back(nb);
+                throw;
+            }
+            replaceElements(b, nb);
+        }
+        Block& blk = *blocks[b];
+        for (Index i = s.pos; i + 1 < blk.count; ++i) {
+            blk.slots[i] = blk.slots[i + 1];
+            slots[blk.slots[i]].pos = i;
+        }
+        --blk.count;
+        s.used = false;
+        ++s.generation;
+        s.block = freeSlot;
+        freeSlot = h.index;
+        --count;
+        if (blk.count == 0) {
+            unlink(b);
+        }
+        return true;
+    }
+
+    template<typename U>
+    bool valid(Handle<U> h) const {
+        return h.index < slots.size() && slots[h.index].used
+            && slots[h.index].generation == h.generation;
+    }
+
+    // O(1) 的带校验访问：失效的 Handle 得到 nullptr
+    template<typename U>
+    U* get(Handle<U> h) {
+        return valid(h) ? blocks[slots[h.index].block]->at(slots[h.index].pos) : nullptr;
+    }
+
+    template<typename U>
+    T const* get(Handle<U> h) const {
+        return const_cast<List*>(this)->get(Handle<T const>(h));
+    }
+
+    // 把所有元素按顺序重新装满块并释放多余的块，Handle 保持有效
+    void compact() {
+        List packed;
+        packed.reserveBlocks(count);
+        for (Index b = head; b != npos; b = blocks[b]->next) {
+            Block& blk = *blocks[b];
+            for (Index i = 0; i < blk.count;) {         // 整段重定位到 packed 的尾块
+                if (packed.tail == npos || packed.blocks[packed.tail]->count == BlockSize) {
+                    packed.linkAfter(packed.tail, packed.newBlock());
+                }
+                Block& to = *packed.blocks[packed.tail];
+                Index n = std::min(blk.count - i, BlockSize - to.count);
+                if constexpr (is_nothrow_relocatable_v<T>) {
+                    relocate(blk.at(i), n, to.raw(to.count));
+                }
+                else {
+                    // 可能抛出异常：只拷贝，原链表保持不变，失败时 packed 析构已拷贝的元素
+                    std::uninitialized_copy(blk.at(i), blk.at(i) + n, to.raw(to.count));
+                }
+                std::copy(blk.slots + i, blk.slots + i + n, to.slots + to.count);
+                to.count += n;
+                i += n;
+            }
+            if constexpr (is_nothrow_relocatable_v<T>) {
+                blk.count = 0;                          // 元素已经搬走，不再析构
+            }
+        }
+        packed.count = count;
+        packed.slots = std::move(slots);
+        packed.freeSlot = freeSlot;
+        for (Index b = packed.head; b != npos; b = packed.blocks[b]->next) {
+            Block& blk = *packed.blocks[b];
+            for (Index i = 0; i < blk.count; ++i) {
+                packed.slots[blk.slots[i]].block = b;
+                packed.slots[blk.slots[i]].pos = i;
+            }
+        }
+        swap(packed);
+    }
+
+    std::size_t blockCount() const { return blocks.size() - freeBlocks.size(); }
+
+    template<typename V>
+    class Iterator {
+    private:
+        using Owner = std::conditional_t<std::is_const_v<V>, List const, List>;
+        Owner* list;
+        Index block;
+        Index pos;
+        friend class List;
+        Iterator(Owner* l, Index b, Index p) : list(l), block(b), pos(p) {}
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<V>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V*;
+        using reference = V&;
+
+        Iterator() : list(nullptr), block(npos), pos(0) {}
+        V& operator*() const { return *list->blocks[block]->at(pos); }
+        V* operator->() const { return &**this; }
+        Iterator& operator++() {
+            if (++pos == list->blocks[block]->count) {
+                block = list->blocks[block]->next;
+                pos = 0;
+            }
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(Iterator const& b) const { return block == b.block && pos == b.pos; }
+        bool operator!=(Iterator const& b) const { return !(*this == b); }
+        Handle<V> handle() const {
+            Index s = list->blocks[block]->slots[pos];
+            return Handle<V>(s, list->slots[s].generation);
+        }
+    };
+
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<T const>;
+
+    iterator begin() { return iterator(this, head, 0); }
+    iterator end() { return iterator(this, npos, 0); }
+    const_iterator begin() const { return const_iterator(this, head, 0); }
+    const_iterator end() const { return const_iterator(this, npos, 0); }
+
+    // 按块遍历，内层循环是连续内存，比逐个 ++iterator 更容易被编译器优化
+    template<typename F>
+    void forEach(F f) {
+        for (Index b = head; b != npos; b = blocks[b]->next) {
+            Block& blk = *blocks[b];
+            for (Index i = 0; i < blk.count; ++i) {
+                f(*blk.at(i));
+            }
+        }
+    }
+
+private:
+    Index newBlock() {
+        if (!freeBlocks.empty()) {
+            Index b = freeBlocks.back();
+            freeBlocks.pop_back();
+            return b;
+        }
+        blocks.push_back(std::make_unique<Block>());
+        return static_cast<Index>(blocks.size() - 1);
+    }
+
+    void reserveBlocks(std::size_t elements) {
+        blocks.reserve((elements + BlockSize - 1) / BlockSize);
+    }
+
+    void linkAfter(Index at, Index b) {
+        Block& blk = *blocks[b];
+        blk.prev = at;
+        blk.next = at == npos ? head : blocks[at]->next;
+        (blk.next == npos ? tail : blocks[blk.next]->prev) = b;
+        (at == npos ? head : blocks[at]->next) = b;
+    }
+
+    void unlink(Index b) {
+        Block& blk = *blocks[b];
+        (blk.prev == npos ? head : blocks[blk.prev]->next) = blk.next;
+        (blk.next == npos ? tail : blocks[blk.next]->prev) = blk.prev;
+        blk.prev = blk.next = npos;
+        freeBlocks.push_back(b);
+    }
+
+    // 把 b 的后一半移到紧随其后的新块中，返回新块。
+    // 重定位抛出异常时（只可能是拷贝），新块退回空闲列表，b 保持不变
+    Index split(Index b) {
+        Index nb = newBlock();
+        Block& from = *blocks[b];
+        Block& to = *blocks[nb];
+        Index keep = from.count / 2;
+        try {
+            relocate(from.at(keep), from.count - keep, to.raw(0));
+        }
+        catch (...) {
+            freeBlocks.push_back(nb);
+            throw;
+        }
+        linkAfter(b, nb);
+        for (Index i = keep; i < from.count; ++i) {
+            to.slots[i - keep] = from.slots[i];
+            slots[from.slots[i]].block = nb;
+            slots[from.slots[i]].pos = i - keep;
+        }
+        to.count = from.count - keep;
+        from.count = keep;
+        return nb;
+    }
+
+    Index acquireSlot() {
+        if (freeSlot != npos) {
+            Index s = freeSlot;
+            freeSlot = slots[s].block;
+            return s;
+        }
+        slots.push_back(Slot{});
+        return static_cast<Index>(slots.size() - 1);
+    }
+
+    template<typename... Args>
+    Handle<T> emplaceAt(Index b, Index p, Args&&... args) {
+        Index s = acquireSlot();
+        if constexpr (is_nothrow_relocatable_v<T>) {
+            Block& blk = *blocks[b];
+            // 先在块外构造，构造抛出异常时块保持不变；再把 [p, count) 整体后移一位，把新元素重定位到 p
+            alignas(T) unsigned char tmp[sizeof(T)];
+            T* value;
+            try {
+                value = ::new (static_cast<void*>(tmp)) T(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                releaseSlot(s);
+                throw;
+            }
+            if (p < blk.count) {
+                relocateOverlapping(blk.at(p), blk.count - p, blk.raw(p + 1));
+            }
+            relocate(value, 1, blk.raw(p));
+        }
+        else {
+            // 移动可能抛出异常：在新块中构造新元素并拷贝原有元素，成功后替换原块，抛出时链表保持不变
+            Block& from = *blocks[b];
+            Index nb = newBlock();
+            Block& to = *blocks[nb];
+            T* first = from.count != 0 ? from.at(0) : nullptr;
+            T* out = to.raw(0);
+            try {
+                ::new (static_cast<void*>(to.raw(p))) T(std::forward<Args>(args)...);
+                try {
+                    out = std::uninitialized_copy(first, first + p, out);
+                    std::uninitialized_copy(first + p, first + from.count, to.raw(p + 1));
+                }
+                catch (...) {
+                    std::destroy(to.raw(0), out);
+                    to.at(p)->~T();
+                    throw;
+                }
+            }
+            catch (...) {
+                freeBlocks.push_back(nb);
+                releaseSlot(s);
+                throw;
+            }
+            replaceElements(b, nb);
+        }
+        Block& blk = *blocks[b];
+        for (Index i = blk.count; i > p; --i) {
+            blk.slots[i] = blk.slots[i - 1];
+            slots[blk.slots[i]].pos = i;
+        }
+        blk.slots[p] = s;
+        ++blk.count;
+        slots[s] = Slot{b, p, slots[s].generation, true};
+        ++count;
+        return Handle<T>(s, slots[s].generation);
+    }
+
+    // nb 中已经构造好块 b 的新内容：把 b 的链接、槽位和计数转给 nb，析构 b 原有的元素，
+    // 然后交换两块的下标，旧存储退回空闲列表。槽位记录的块下标不变
+    void replaceElements(Index b, Index nb) {
+        Block& from = *blocks[b];
+        Block& to = *blocks[nb];
+        to.prev = from.prev;
+        to.next = from.next;
+        std::copy(from.slots, from.slots + from.count, to.slots);
+        to.count = from.count;
+        for (Index i = 0; i < from.count; ++i) {
+            from.at(i)->~T();
+        }
+        from.count = 0;
+        from.prev = from.next = npos;
+        blocks[b].swap(blocks[nb]);
+        freeBlocks.push_back(nb);
+    }
+
+    void releaseSlot(Index s) {
+        slots[s].block = freeSlot;
+        freeSlot = s;
+    }
+
+    // 追加一个元素并沿用给定的槽位编号，槽位表由调用者负责
+    template<typename V>
+    void appendWithSlot(Index s, V&& value) {
+        if (tail == npos || blocks[tail]->count == BlockSize) {
+            linkAfter(tail, newBlock());
+        }
+        Block& blk = *blocks[tail];
+        try {
+            ::new (static_cast<void*>(blk.raw(blk.count))) T(std::forward<V>(value));
+        }
+        catch (...) {
+            if (blk.count == 0) {
+                unlink(tail);
+            }
+            throw;
+        }
+        blk.slots[blk.count++] = s;
+        ++count;
+    }
+
+    // 逐块转换：槽位编号和代数原样保留，源列表的 (index, generation) 在新列表中指向对应元素
+    template<typename U>
+    void copyFrom(List<U> const& b) {
+        reserveBlocks(b.count);
+        for (Index i = b.head; i != npos; i = b.blocks[i]->next) {
+            auto& blk = *b.blocks[i];
+            for (Index j = 0; j < blk.count; ++j) {
+                appendWithSlot(blk.slots[j], static_cast<T>(*blk.at(j)));
+            }
+        }
+        slots.resize(b.slots.size());
+        for (std::size_t s = 0; s < slots.size(); ++s) {
+            slots[s].generation = b.slots[s].generation;
+            slots[s].used = b.slots[s].used;
+            slots[s].block = b.slots[s].block;      // 空闲槽位的链接原样保留
+        }
+        freeSlot = b.freeSlot;
+        for (Index i = head; i != npos; i = blocks[i]->next) {
+            Block& blk = *blocks[i];
+            for (Index j = 0; j < blk.count; ++j) {
+                slots[blk.slots[j]].block = i;
+                slots[blk.slots[j]].pos = j;
+            }
+        }
+    }
+};
+
+template<typename T>        // 在类外面的成员类模板定义
+    template<typename U>
+class List<T>::Handle {
+    static_assert(std::is_same_v<std::remove_const_t<U>, T>, "Handle<U>: U must be T or T const");
+private:
+    Index index = npos;
+    Index generation = 0;
+    friend class List;
+    template<typename> friend class List<T>::Handle;
+    Handle(Index i, Index g) : index(i), generation(g) {}
+public:
+    Handle() = default;
+    // Handle<T> 可以隐式转换为只读的 Handle<T const>
+    template<typename V, typename = std::enable_if_t<std::is_same_v<U, T const> && std::is_same_v<V, T>>>
+    Handle(Handle<V> const& h) : index(h.index), generation(h.generation) {}
+
+    bool operator==(Handle const& b) const { return index == b.index && generation == b.generation; }
+    bool operator!=(Handle const& b) const { return !(*this == b); }
+};
+
+template<typename T>        // 在类外面的成员函数模板定义
+    template<typename T2>
+List<T>::List(List<T2> const& b) {
+    copyFrom(b);
+}
+
+template<typename T>        // 在类外面的静态数据成员模板定义
+    template<typename U>
+U List<T>::zero = 0;
+#endif //CXX_TEMPLATES_UNROLLEDLIST_HPP
@@ -0,0 +1,172 @@
+#include "hashappend.hpp"
+#include "../../ch04/4_2/customer.hpp"
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace crm {
+
+struct Address
+{
+    std::string first;
+    std::string last;
+    std::string city;
+    int zip;
+
+    bool operator==(Address const& b) const
+    {
+        return zip == b.zip && first == b.first && last == b.last && city == b.city;
+    }
+};
+
+// 与 Address 在同一个命名空间中，AppendHash 通过 ADL 找到它
+template<typename H>
+void hash_append(H& h, Address const& a) noexcept
+{
+    hashing::append(h, a.first, a.last, a.city, a.zip);
+}
+
+} // namespace crm
+
+// Customer 在全局命名空间中，全局的 hash_append 同样通过 ADL 找到
+template<typename H>
+void hash_append(H& h, Customer const& c) noexcept
+{
+    hashing::append(h, c.getName());
+}
+
+// 定义在 hashing 之外的哈希器：字段经由 hashing::append 追加，仍然能找到 std::string 等的版本
+namespace mine {
+
+class Djb2
+{
+private:
+    std::uint64_t state = 5381;
+public:
+    void operator()(void const* data, std::size_t n) noexcept
+    {
+        auto p = static_cast<unsigned char const*>(data);
+        for (std::size_t i = 0; i < n; ++i) {
+            state = state * 33 + p[i];
+        }
+    }
+    explicit operator std::size_t() noexcept { return static_cast<std::size_t>(state); }
+};
+
+} // namespace mine
+
+// 常见写法一：拼接成一个字符串再哈希，每次调用都要分配内存
+struct ConcatHash
+{
+    std::size_t operator()(crm::Address const& a) const
+    {
+        return std::hash<std::string>()(a.first + '\x1f' + a.last + '\x1f' + a.city + '\x1f'
+                                        + std::to_string(a.zip));
+    }
+};
+
+// 常见写法二：逐字段 std::hash 再用 boost::hash_combine 的方式合并
+struct CombineHash
+{
+    static void combine(std::size_t& seed, std::size_t h)
+    {
+        seed ^= h + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+    }
+    std::size_t operator()(crm::Address const& a) const
+    {
+        std::size_t seed = 0;
+        combine(seed, std::hash<std::string>()(a.first));
+        combine(seed, std::hash<std::string>()(a.last));
+        combine(seed, std::hash<std::string>()(a.city));
+        combine(seed, std::hash<int>()(a.zip));
+        return seed;
+    }
+};
+
+template<typename F>
+double measure(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename Hash>
+void bench(char const* name, std::vector<crm::Address> const& keys)
+{
+    Hash hash;
+    std::size_t sink = 0;
+    double hashMs = measure([&] {
+        for (int r = 0; r < 10; ++r) {
+            for (auto const& k : keys) {
+                sink += hash(k);
+            }
+        }
+    });
+    std::unordered_set<crm::Address, Hash> set;
+    double insertMs = measure([&] {
+        for (auto const& k : keys) {
+            set.insert(k);
+        }
+    });
+    std::size_t found = 0;
+    double findMs = measure([&] {
+        for (auto const& k : keys) {
+            found += set.count(k);
+        }
+    });
+    std::cout << name << ": hash " << hashMs * 1e5 / keys.size() << " ns/key, insert "
+              << insertMs << " ms, find " << findMs << " ms, max bucket "
+              << [&] {
+                     std::size_t m = 0;
+                     for (std::size_t b = 0; b < set.bucket_count(); ++b) {
+                         m = std::max(m, set.bucket_size(b));
+                     }
+                     return m;
+                 }()
+              << (found == set.size() && sink != 1 ? "" : " (MISMATCH)") << '\n';
+}
+
+int main()
+{
+    // 字段拼接的歧义：("ab", "c") 与 ("a", "bc") 的哈希不同
+    AppendHash<> h;
+    // 内容相同、地址不同的两个 C 字符串
+    char buffer[] = "alice";
+    char const copy[] = "alice";
+    char* name = buffer;
+    std::cout << std::boolalpha
+              << "pair(\"ab\",\"c\") != pair(\"a\",\"bc\"): "
+              << (h(std::pair("ab", "c")) != h(std::pair("a", "bc"))) << '\n'
+              << "Customer hashes like its name: "
+              << (h(Customer("alice")) == h(std::string_view("alice"))) << '\n'
+              << "-0.0 == +0.0: " << (h(-0.0) == h(0.0)) << '\n'
+              << "char* hashes like char const*: "
+              << (h(name) == h(static_cast<char const*>(copy))) << '\n';
+    AppendHash<mine::Djb2> mh;
+    crm::Address a{"ada", "lovelace", "london", 12345};
+    std::cout << "hasher outside namespace hashing: "
+              << (mh(a) == mh(std::vector<crm::Address>{a}) ? "MISMATCH" : "ok") << '\n';
+
+    std::mt19937 rng(1);
+    std::vector<std::string> firsts, lasts, cities;
+    for (int i = 0; i < 200; ++i) {
+        firsts.push_back("first" + std::to_string(i));
+        lasts.push_back("lastname-" + std::to_string(i * 7919));
+        cities.push_back("city of " + std::to_string(i * 31));
+    }
+    std::vector<crm::Address> keys(1'000'000);
+    for (auto& k : keys) {
+        k = crm::Address{firsts[rng() % 200], lasts[rng() % 200], cities[rng() % 200],
+                         static_cast<int>(rng() % 100000)};
+    }
+    bench<ConcatHash>("concat + std::hash     ", keys);
+    bench<CombineHash>("hash_combine           ", keys);
+    bench<AppendHash<hashing::Fnv1a>>("hash_append + FNV-1a   ", keys);
+    bench<AppendHash<hashing::WyHasher>>("hash_append + WyHasher ", keys);
+}
@@ -0,0 +1,271 @@
+#ifndef CXX_TEMPLATES_HASHAPPEND_HPP
+#define CXX_TEMPLATES_HASHAPPEND_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// hash_append：类型只描述“哪些字段参与哈希”，哈希算法由可替换的流式哈希器决定。
+//     struct Key { std::string first, last; int zip; };
+//     template<typename H>
+//     void hash_append(H& h, Key const& k) { hashing::append(h, k.first, k.last, k.zip); }
+// hash_append 与类型定义在同一个命名空间中，通过 ADL（见 adl.cpp）找到；
+// 基本类型和标准库类型的版本在命名空间 hashing 中。字段要通过定制点 hashing::append 追加，
+// 它同时看得到两者：不加限定地调用 hash_append 只在哈希器也定义在 hashing 中时才能找到
+// hashing 里的版本，换成其他命名空间的哈希器就会编译失败。
+// 字段按字节直接送入哈希器，不需要先拼接成一个临时字符串。
+//
+// 哈希器只需要两个操作：
+//     void operator()(void const* data, std::size_t n) noexcept;   // 追加字节
+//     explicit operator std::size_t() noexcept;                     // 取结果
+
+namespace hashing {
+
+// FNV-1a：最简单的流式哈希，逐字节处理
+class Fnv1a
+{
+private:
+    std::uint64_t state = 0xcbf29ce484222325ull;
+public:
+    void operator()(void const* data, std::size_t n) noexcept
+    {
+        auto p = static_cast<unsigned char const*>(data);
+        for (std::size_t i = 0; i < n; ++i) {
+            state = (state ^ p[i]) * 0x100000001b3ull;
+        }
+    }
+    explicit operator std::size_t() noexcept { return static_cast<std::size_t>(state); }
+};
+
+// wyhash 风格的哈希器：每次追加的字节用 64x64->128 乘法混合进状态。
+// 不跨调用缓冲，短输入用 wyhash 的重叠读取技巧，没有变长 memcpy；
+// 因此结果与字节如何分批追加有关，但同一个类型的 hash_append 每次分批方式都相同。
+class WyHasher
+{
+private:
+    static constexpr std::uint64_t s0 = 0xa0761d6478bd642full;
+    static constexpr std::uint64_t s1 = 0xe7037ed1a0b428dbull;
+    static constexpr std::uint64_t s2 = 0x8ebc6af09c88c6e3ull;
+
+    std::uint64_t state;
+
+    static std::uint64_t mix(std::uint64_t a, std::uint64_t b) noexcept
+    {
+#ifdef __SIZEOF_INT128__
+        __extension__ typedef unsigned __int128 U128;       // __extension__：-pedantic 下不警告
+        U128 r = static_cast<U128>(a) * b;
+        return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64);
+#else
+        // 没有 128 位整数（如 MSVC）：拆成 32 位的四个部分积
+        std::uint64_t aLo = a & 0xffffffffu, aHi = a >> 32;
+        std::uint64_t bLo = b & 0xffffffffu, bHi = b >> 32;
+        std::uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+        std::uint64_t mid = (ll >> 32) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+        std::uint64_t lo = (mid << 32) | (ll & 0xffffffffu);
+        std::uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+        return lo ^ hi;
+#endif
+    }
+    static std::uint64_t read64(unsigned char const* p) noexcept
+    {
+        std::uint64_t v;
+        std::memcpy(&v, p, 8);
+        return v;
+    }
+    static std::uint64_t read32(unsigned char const* p) noexcept
+    {
+        std::uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+public:
+    explicit WyHasher(std::uint64_t seed = 0) noexcept : state(seed ^ s0) {}
+
+    void operator()(void const* data, std::size_t n) noexcept
+    {
+        auto p = static_cast<unsigned char const*>(data);
+        std::uint64_t a, b;
+        if (n <= 16) {
+            if (n >= 4) {
+                // 4..16 字节：首尾各读两次，可能重叠
+                std::size_t off = (n >> 3) << 2;
+                a = (read32(p) << 32) | read32(p + off);
+                b = (read32(p + n - 4) << 32) | read32(p + n - 4 - off);
+            }
+            else if (n > 0) {
+                a = (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[n >> 1]) << 8) | p[n - 1];
+                b = 0;
+            }
+            else {
+                a = b = 0;
+            }
+        }
+        else {
+            for (; n > 16; p += 16, n -= 16) {
+                state = mix(read64(p) ^ s1, read64(p + 8) ^ state);
+            }
+            a = read64(p + n - 16);                 // 最后 16 字节，可能与上一块重叠
+            b = read64(p + n - 8);
+        }
+        state = mix(a ^ s1, b ^ state ^ n);
+    }
+
+    explicit operator std::size_t() noexcept
+    {
+        return static_cast<std::size_t>(mix(state ^ s2, s1));
+    }
+};
+
+// 内存表示与值一一对应的类型可以直接按字节哈希（整数、枚举、指针）
+template<typename T>
+constexpr bool isContiguouslyHashable = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+template<typename H, typename T>
+std::enable_if_t<isContiguouslyHashable<T>> hash_append(H& h, T const& x) noexcept
+{
+    h(std::addressof(x), sizeof(x));
+}
+
+// 浮点数：+0.0 和 -0.0 相等，哈希值也必须相同
+template<typename H, typename T>
+std::enable_if_t<std::is_floating_point_v<T>> hash_append(H& h, T x) noexcept
+{
+    if (x == 0) {
+        x = 0;
+    }
+    h(&x, sizeof(x));
+}
+
+// 字符串追加内容和长度：("ab", "c") 与 ("a", "bc") 的哈希不同
+template<typename H, typename CharT, typename Traits>
+void hash_append(H& h, std::basic_string_view<CharT, Traits> s) noexcept
+{
+    h(s.data(), s.size() * sizeof(CharT));
+    hash_append(h, s.size());
+}
+
+template<typename H, typename CharT, typename Traits, typename Alloc>
+void hash_append(H& h, std::basic_string<CharT, Traits, Alloc> const& s) noexcept
+{
+    hash_append(h, std::basic_string_view<CharT, Traits>(s));
+}
+
+// C 字符串按内容哈希，而不是按指针；char* 需要单独的重载，否则指针模板是更好的匹配
+template<typename H>
+void hash_append(H& h, char const* s) noexcept
+{
+    hash_append(h, std::string_view(s));
+}
+
+template<typename H>
+void hash_append(H& h, char* s) noexcept
+{
+    hash_append(h, std::string_view(s));
+}
+
+template<typename H, typename T, typename U>
+void hash_append(H& h, std::pair<T, U> const& p) noexcept;
+
+template<typename H, typename... Ts>
+void hash_append(H& h, std::tuple<Ts...> const& t) noexcept;
+
+template<typename H, typename T, std::size_t N>
+void hash_append(H& h, std::array<T, N> const& a) noexcept;
+
+template<typename H, typename T, typename Alloc>
+void hash_append(H& h, std::vector<T, Alloc> const& v) noexcept;
+
+template<typename H, typename T>
+void hash_append(H& h, std::optional<T> const& o) noexcept;
+
+// 多个值依次追加
+template<typename H, typename T1, typename T2, typename... Ts>
+void hash_append(H& h, T1 const& x1, T2 const& x2, Ts const&... xs) noexcept
+{
+    hash_append(h, x1);
+    hash_append(h, x2);
+    (hash_append(h, xs), ...);
+}
+
+template<typename H, typename T, typename U>
+void hash_append(H& h, std::pair<T, U> const& p) noexcept
+{
+    hash_append(h, p.first, p.second);
+}
+
+template<typename H, typename... Ts>
+void hash_append(H& h, std::tuple<Ts...> const& t) noexcept
+{
+    std::apply([&h](Ts const&... xs) { (hash_append(h, xs), ...); }, t);
+}
+
+template<typename H, typename T, std::size_t N>
+void hash_append(H& h, std::array<T, N> const& a) noexcept
+{
+    if constexpr (isContiguouslyHashable<T>) {
+        h(a.data(), sizeof(a));
+    }
+    else {
+        for (auto const& x : a) {
+            hash_append(h, x);
+        }
+    }
+}
+
+template<typename H, typename T, typename Alloc>
+void hash_append(H& h, std::vector<T, Alloc> const& v) noexcept
+{
+    if constexpr (isContiguouslyHashable<T>) {
+        h(v.data(), v.size() * sizeof(T));
+    }
+    else {
+        for (auto const& x : v) {
+            hash_append(h, x);
+        }
+    }
+    hash_append(h, v.size());
+}
+
+template<typename H, typename T>
+void hash_append(H& h, std::optional<T> const& o) noexcept
+{
+    if (o) {
+        hash_append(h, *o);
+    }
+    hash_append(h, o.has_value());
+}
+
+// 定制点，也是调用入口：先让 hashing 中的版本可见，再用不加限定的调用触发 ADL
+// （与 std::swap 的惯用法相同），因此与哈希器定义在哪个命名空间无关。
+// 不想通过它调用时，需要在自己的 hash_append 中先写 using hashing::hash_append;
+template<typename H, typename... Ts>
+void append(H& h, Ts const&... xs) noexcept
+{
+    using hashing::hash_append;
+    (hash_append(h, xs), ...);
+}
+
+} // namespace hashing
+
+// 可以直接用作 std::unordered_set / unordered_map 的哈希函数；透明，可以用任何可哈希的类型查找
+template<typename Hasher = hashing::WyHasher>
+struct AppendHash
+{
+    using is_transparent = void;
+    template<typename T>
+    std::size_t operator()(T const& x) const noexcept
+    {
+        Hasher h;
+        hashing::append(h, x);
+        return static_cast<std::size_t>(h);
+    }
+};
+#endif //CXX_TEMPLATES_HASHAPPEND_HPP
@@ -0,0 +1,68 @@
+#!/bin/sh
+# 生成一个由 N 个翻译单元组成的工程（默认 200 个），每个翻译单元都使用
+# Stack<int>、Stack<std::string>、print() 和 foreach()，分别在
+#   1. 默认的包含模型（每个翻译单元各自实例化）
+#   2. 定义 CXX_TEMPLATES_EXTERN_INSTANTIATIONS（实例化只在 commoninst.cpp 中进行一次）
+# 两种模式下编译并链接，比较总构建时间、-ftime-report 中累计的模板实例化时间和目标文件大小。
+# 用法：sh buildbench.sh [翻译单元个数] [g++]
+N=${1:-200}
+CXX=${2:-g++}
+DIR=$(cd "$(dirname "$0")" && pwd)
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+i=0
+while [ $i -lt "$N" ]; do
+    cat > "$TMP/tu$i.cpp" <<EOF
+#include "$DIR/commoninst.hpp"
+
+static void show$i(int x) { print(x); }
+
+void use$i()
+{
+    Stack<int> ints;
+    ints.push($i);
+    Stack<std::string> strs;
+    strs.push("tu$i");
+    print(ints.top(), strs.top());
+    print(ints.top() * 0.5);
+    std::vector<int> v(3, $i);
+    foreach(v.begin(), v.end(), &show$i);
+    ints.pop();
+    strs.pop();
+}
+EOF
+    i=$((i + 1))
+done
+{
+    i=0
+    while [ $i -lt "$N" ]; do echo "void use$i();"; i=$((i + 1)); done
+    echo "int main() {"
+    i=0
+    while [ $i -lt "$N" ]; do echo "    use$i();"; i=$((i + 1)); done
+    echo "}"
+} > "$TMP/main.cpp"
+
+now() { date +%s%N; }
+
+build() {
+    mode=$1; shift
+    rm -f "$TMP"/*.o "$TMP"/*.report
+    t0=$(now)
+    for src in "$TMP"/tu*.cpp "$TMP/main.cpp" "$@"; do
+        obj="$TMP/$(basename "$src" .cpp).o"
+        "$CXX" -std=c++17 -O2 -ftime-report -c "$src" -o "$obj" $FLAGS 2> "$obj.report" || exit 1
+    done
+    "$CXX" "$TMP"/*.o -o "$TMP/app" || exit 1
+    ms=$(( ($(now) - t0) / 1000000 ))
+    # 累计每个翻译单元 -ftime-report 中 "template instantiation" 一行的墙钟时间
+    inst=$(cat "$TMP"/*.report | awk -F: '/template instantiation/ {
+        gsub(/\([^)]*\)/, "", $2); split($2, f, " "); s += f[3] } END { printf "%.2f", s }')
+    size=$(cat "$TMP"/*.o | wc -c)
+    printf '%-10s build %6s ms, template instantiation %6s s, objects %8s bytes\n' \
+        "$mode" "$ms" "$inst" "$size"
+}
+
+echo "$N translation units:"
+FLAGS="" build implicit
+FLAGS="-DCXX_TEMPLATES_EXTERN_INSTANTIATIONS" build extern "$DIR/commoninst.cpp"
@@ -0,0 +1,13 @@
+#include "commoninst.hpp"
+
+// commoninst.hpp 中声明的特化的显式实例化定义，编译一次后作为库链接
+template class Stack<int>;
+template class Stack<std::string>;
+
+template void print<int>(int);
+template void print<double>(double);
+template void print<std::string>(std::string);
+template void print<int, std::string>(int, std::string);
+
+template void foreach<std::vector<int>::iterator, void (*)(int)>(
+    std::vector<int>::iterator, std::vector<int>::iterator, void (*)(int));
@@ -0,0 +1,25 @@
+#ifndef CXX_TEMPLATES_COMMONINST_HPP
+#define CXX_TEMPLATES_COMMONINST_HPP
+#include <string>
+#include <vector>
+#include "../../ch02/2_1/stack1.hpp"
+#include "../../ch04/4_1/varprint2.hpp"
+#include "../../ch11/11_1/foreach.hpp"
+
+// 常用特化的显式实例化声明（可选）：
+// 定义 CXX_TEMPLATES_EXTERN_INSTANTIATIONS 后，包含本头文件的翻译单元不再各自实例化这些特化，
+// 改为链接 commoninst.cpp 中唯一的一份显式实例化定义。
+// 类内定义的成员（如 Stack<>::empty()）是内联的，仍然会在使用处实例化以便内联。
+#ifdef CXX_TEMPLATES_EXTERN_INSTANTIATIONS
+extern template class Stack<int>;
+extern template class Stack<std::string>;
+
+extern template void print<int>(int);
+extern template void print<double>(double);
+extern template void print<std::string>(std::string);
+extern template void print<int, std::string>(int, std::string);
+
+using IntIter = std::vector<int>::iterator;
+extern template void foreach<IntIter, void (*)(int)>(IntIter, IntIter, void (*)(int));
+#endif
+#endif //CXX_TEMPLATES_COMMONINST_HPP